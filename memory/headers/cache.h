@@ -0,0 +1,49 @@
+#ifndef __CACHE_H__
+#define __CACHE_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+#define CACHE_LINE 64
+
+// Niveis fixos; a LLC e configurada com -K e -U
+#define L1_CACHE_SIZE (32 * 1024)
+#define L1_CACHE_WAYS 8
+#define L2_CACHE_SIZE (256 * 1024)
+#define L2_CACHE_WAYS 8
+
+// Custos em ciclos usados no tempo medio de acesso
+#define L1_CACHE_LATENCY 4
+#define L2_CACHE_LATENCY 12
+#define LLC_LATENCY 40
+#define DRAM_LATENCY 200
+
+#define CACHE_INVALID 0xFFFFFFFFu
+
+typedef struct CacheLevel CacheLevel;
+
+// Cache associativa por conjunto com LRU: a linha (conjunto, via) fica em set * ways + way, e as tags de um
+// conjunto ficam seguidas para serem comparadas com SIMD
+struct CacheLevel{
+    char *name;
+    int sets; // potencia de 2
+    int setBits;
+    int ways;
+    unsigned int *tags; // endereco da linha sem os bits do conjunto (CACHE_INVALID se vazia)
+    long long *stamps; // ultimo uso
+    unsigned int *generations; // geracao do frame quando a linha foi trazida
+    long long clock;
+    long long accesses;
+    long long misses;
+};
+
+extern void createCaches();
+extern int isCacheGeometryValid(int llcKilobytes, int llcWays);
+extern int pageColors();
+extern int pageColor(Process *process, int pageNumber);
+extern void invalidateFrameCaches(int frame);
+extern void recordCacheAccess(Process *process, int pageNumber, int offset);
+extern void printCacheStatistics();
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef __GENERATOR_H__
+#define __GENERATOR_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+
+// Padroes de referencia dos processos sinteticos
+#define PATTERN_UNIFORM 0
+#define PATTERN_ZIPF 1
+#define PATTERN_SCAN 2
+#define PATTERN_LOOP 3
+#define PATTERN_PHASE 4
+
+// Referencias ao conjunto quente entre duas varreduras sequenciais (padrao de varredura)
+#define SCAN_HOT_LENGTH 4096
+
+// Referencias de cada fase e fracao das paginas usada em uma fase (padrao de fases)
+#define PHASE_LENGTH 10000
+#define PHASE_FRACTION 8
+
+typedef struct Generator Generator;
+typedef struct ZipfColumn ZipfColumn;
+typedef struct ZipfTable ZipfTable;
+
+// Fluxo xoshiro256** proprio do processo e a posicao no padrao
+struct Generator{
+    unsigned long long state[4];
+    int pattern;
+    int pages;
+    long long references;
+    int position; // proxima pagina do laco
+    int phaseStart; // primeira pagina da fase atual
+};
+
+// Tabela de alias de Walker da distribuicao de Zipf sobre NUM_PAGES paginas, compartilhada pelos processos
+struct ZipfColumn{
+    unsigned int threshold; // probabilidade de ficar na coluna, em unidades de 2^-32
+    int alias;
+};
+
+struct ZipfTable{
+    ZipfColumn *columns;
+};
+
+extern unsigned long long generatorSeed();
+extern Generator* createGenerator(int pid);
+extern unsigned long long nextRandom(Generator *generator);
+extern int randomBelow(Generator *generator, int bound);
+extern int nextGeneratedPage(Generator *generator);
+extern int nextGeneratedWrite(Generator *generator);
+extern int nextGeneratedOffset(Generator *generator);
+
+#endif
@@ -6,14 +6,14 @@
 #include <unistd.h>
 #include <time.h>
 
-#define MAX_FRAMES 128
 #define MAX_PROCESSES 32
-#define MAX_PAGES 64
+#define MAX_NODES 8
+#define MAX_MIGRATION_STREAK 255
 
 #define HELP_TEXT \
-"Simula o funcionamento de um gerenciador de memoria virtual com algoritmo LRU\n\
+"Simula o funcionamento de um gerenciador de memoria virtual com algoritmos de substituicao de paginas\n\
 Para execuder rode:\n\
-\t [executavel] [-f#] [-p#] [-v#] [-w#] [-s#] [-l#]\n\
+\t [executavel] [-f#] [-p#] [-v#] [-w#] [-s#] [-l#] [-b#] [-r#] [-tarquivo] [-z#] [-m#] [-k#] [-d#] [-c#] [-u#] [-n#] [-e#] [-a#] [-j#] [-y#] [-x#] [-i#] [-g#] [-q#] [-o#] [-T#] [-S#] [-W#] [-Q#] [-A#] [-D#] [-Z#] [-C#] [-I#] [-L#] [-F#] [-N#] [-P#] [-M#] [-R#] [-K#] [-U#] [-O#]\n\
 \n\
 \tf\t: Quantidade de frames na memoria principal\n\
 \tp\t: Quantidade de processos\n\
@@ -21,6 +21,43 @@ Para execuder rode:\n\
 \tw\t: Limite do working set\n\
 \ts\t: Tempo de espera entre ciclos em segundos\n\
 \tl\t: Quantidade maxima de ciclos\n\
+\tb\t: Modo em lote sem espera e sem impressao por acesso, com progresso a cada # ciclos (0 desativado)\n\
+\tr\t: Politica de substituicao (0 LRU, 1 FIFO, 2 Clock, 3 Clock-Pro, 4 LFU, 5 2Q, 6 ARC, 7 OPT, em janela sem trace, 8 working set de Denning)\n\
+\tt\t: Arquivo de trace de referencias (texto no formato do Valgrind lackey ou binario)\n\
+\tz\t: Tamanho da pagina virtual em bytes usado para traduzir os enderecos do trace\n\
+\tm\t: Curvas de taxa de faltas do LRU por tamanho de memoria (0 desativado, 1 exata, 2 amostrada com SHARDS)\n\
+\tk\t: Quantidade maxima de paginas acompanhadas por curva no modo amostrado\n\
+\td\t: Janela do working set em referencias do processo, usada pela politica 8\n\
+\tc\t: Controle de carga por taxa de faltas (PFF), medida a cada # referencias do processo (0 desativado)\n\
+\tu\t: Taxa de faltas (%) acima da qual o conjunto residente cresce ate o limite -w\n\
+\tn\t: Taxa de faltas (%) abaixo da qual o conjunto residente encolhe e cede frames\n\
+\te\t: Entradas da TLB L1 (0 desativa o modelo de TLB)\n\
+\ta\t: Associatividade da TLB L1\n\
+\tj\t: Entradas da TLB L2 (0 sem L2)\n\
+\ty\t: Associatividade da TLB L2\n\
+\tx\t: Substituicao nos conjuntos da TLB (0 LRU, 1 FIFO, 2 aleatoria)\n\
+\ti\t: Entradas da TLB marcadas com ASID, sem flush na troca de processo (0 ou 1)\n\
+\tg\t: Padrao de referencias dos processos (0 uniforme, 1 Zipf, 2 Zipf com varreduras, 3 laco, 4 fases)\n\
+\tq\t: Expoente da distribuicao de Zipf em centesimos\n\
+\to\t: Semente dos geradores (0 usa o relogio)\n\
+\tT\t: Threads simulando os processos em paralelo, disputando os frames livres (0 sequencial, exige -l)\n\
+\tS\t: Latencia de leitura do swap em microssegundos (0 desativa o modelo de swap)\n\
+\tW\t: Latencia de escrita do swap em microssegundos\n\
+\tQ\t: Pedidos simultaneos na fila do swap (1 a 64)\n\
+\tA\t: Paginas lidas antecipadamente nas faltas sequenciais (0 desativado)\n\
+\tD\t: Porcentagem de escritas nas referencias sinteticas\n\
+\tZ\t: Porcentagem dos frames reservada ao pool comprimido entre a memoria e o swap (0 desativado, exige -S)\n\
+\tC\t: Razao de compressao mediana das paginas em decimos\n\
+\tI\t: Porcentagem de paginas incompressiveis\n\
+\tL\t: Paginas iniciais dos processos que pertencem a uma biblioteca compartilhada somente leitura (0 desativado)\n\
+\tF\t: Chance (%) de o novo processo ser criado por fork de um processo ativo, com copia na escrita\n\
+\tN\t: Nos de memoria NUMA, com os processos fixos no no pid % # (0 desativado)\n\
+\tP\t: Alocacao dos frames entre os nos (0 primeiro toque, 1 intercalada, 2 preferencial no no 0), usando outro no quando o escolhido esta cheio\n\
+\tM\t: Acessos remotos seguidos a uma pagina que a migram para o no do processo (0 sem migracao)\n\
+\tR\t: Latencia de um acesso a um no remoto em nanossegundos\n\
+\tK\t: Tamanho da LLC em KB no modelo de caches L1/L2/LLC indexadas pelo endereco fisico (0 desativado)\n\
+\tU\t: Associatividade da LLC\n\
+\tO\t: Alocacao dos frames (0 primeiro livre, 1 coloracao de paginas pela LLC, exige -K)\n\
 "
 
 #define PROCESS_CREATION_ERROR 2
@@ -30,6 +67,7 @@ Para execuder rode:\n\
 #define OVER_MAX 6
 #define COUNTER_END 7
 #define HELP 8
+#define TRACE_ERROR 9
 
 extern void exitProgram(int error, char *errorMessage);
 
@@ -0,0 +1,26 @@
+#ifndef __LOADCONTROL_H__
+#define __LOADCONTROL_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+// Estados do processo no controle de carga
+#define PROCESS_READY 0
+#define PROCESS_SUSPENDED 1
+
+// Prioridades dos processos aleatorios (maior numero, maior prioridade)
+#define PROCESS_PRIORITIES 4
+
+// Ajuste do conjunto residente ao fim de uma janela de medicao
+#define RESIDENT_KEEP 0
+#define RESIDENT_GROW 1
+#define RESIDENT_SHRINK 2
+
+extern int updateFaultRate(Process *process, int fault);
+extern Process* chooseFrameDonor(Process **processes, int count, Process *faulting);
+extern Process* chooseSuspendVictim(Process **processes, int count, Process *faulting);
+extern Process* chooseResumeCandidate(Process **processes, int count, int freeFrames);
+extern int residentPages(Process *process);
+
+#endif
@@ -9,6 +9,43 @@
 #define WORKING_SET_LIMIT getWorkingSetLimit()
 #define WAIT_TIME getWaitTime()
 #define STOPPING_LIMIT getStoppingLimit()
+#define BATCH_INTERVAL getBatchInterval()
+#define REPLACEMENT_POLICY getReplacementPolicy()
+#define TRACE_FILE getTraceFile()
+#define VIRTUAL_PAGE_SIZE getVirtualPageSize()
+#define MRC_MODE getMrcMode()
+#define SHARDS_SIZE getShardsSize()
+#define WORKING_SET_WINDOW getWorkingSetWindow()
+#define PFF_INTERVAL getPffInterval()
+#define PFF_UPPER getPffUpper()
+#define PFF_LOWER getPffLower()
+#define TLB_ENTRIES getTlbEntries()
+#define TLB_WAYS getTlbWays()
+#define TLB_L2_ENTRIES getTlbL2Entries()
+#define TLB_L2_WAYS getTlbL2Ways()
+#define TLB_REPLACEMENT getTlbReplacement()
+#define TLB_ASID getTlbAsid()
+#define PATTERN getPattern()
+#define ZIPF_EXPONENT getZipfExponent()
+#define SEED getSeed()
+#define THREADS getThreads()
+#define SWAP_READ_LATENCY getSwapReadLatency()
+#define SWAP_WRITE_LATENCY getSwapWriteLatency()
+#define SWAP_QUEUE_DEPTH getSwapQueueDepth()
+#define SWAP_READAHEAD getSwapReadahead()
+#define WRITE_RATIO getWriteRatio()
+#define ZSWAP_PERCENT getZswapPercent()
+#define ZSWAP_RATIO getZswapRatio()
+#define ZSWAP_INCOMPRESSIBLE getZswapIncompressible()
+#define SHARED_PAGES getSharedPages()
+#define FORK_RATIO getForkRatio()
+#define NUMA_NODES getNumaNodes()
+#define NUMA_POLICY getNumaPolicy()
+#define NUMA_MIGRATION getNumaMigration()
+#define NUMA_REMOTE_LATENCY getNumaRemoteLatency()
+#define CACHE_SIZE getCacheSize()
+#define CACHE_WAYS getCacheWays()
+#define PAGE_COLORING getPageColoring()
 
 extern int getFrames();
 extern int getMaxProcesses();
@@ -16,6 +53,43 @@ extern int getNumPages();
 extern int getWorkingSetLimit();
 extern int getWaitTime();
 extern int getStoppingLimit();
+extern int getBatchInterval();
+extern int getReplacementPolicy();
+extern char* getTraceFile();
+extern int getVirtualPageSize();
+extern int getMrcMode();
+extern int getShardsSize();
+extern int getWorkingSetWindow();
+extern int getPffInterval();
+extern int getPffUpper();
+extern int getPffLower();
+extern int getTlbEntries();
+extern int getTlbWays();
+extern int getTlbL2Entries();
+extern int getTlbL2Ways();
+extern int getTlbReplacement();
+extern int getTlbAsid();
+extern int getPattern();
+extern int getZipfExponent();
+extern int getSeed();
+extern int getThreads();
+extern int getSwapReadLatency();
+extern int getSwapWriteLatency();
+extern int getSwapQueueDepth();
+extern int getSwapReadahead();
+extern int getWriteRatio();
+extern int getZswapPercent();
+extern int getZswapRatio();
+extern int getZswapIncompressible();
+extern int getSharedPages();
+extern int getForkRatio();
+extern int getNumaNodes();
+extern int getNumaPolicy();
+extern int getNumaMigration();
+extern int getNumaRemoteLatency();
+extern int getCacheSize();
+extern int getCacheWays();
+extern int getPageColoring();
 extern void readArgumentsFromConsole(int argc, char *argv[]);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef __MRC_H__
+#define __MRC_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+
+// Modos de calculo das curvas de faltas (MRC)
+#define MRC_DISABLED 0
+#define MRC_EXACT 1
+#define MRC_SHARDS 2
+
+// Espaco do hash espacial do SHARDS: a referencia e amostrada se hash(pagina) < limiar
+#define SHARDS_MODULUS (1 << 24)
+
+typedef struct StackAnalyzer StackAnalyzer;
+
+/*
+ * Distancias de pilha de Mattson de um fluxo de referencias. Cada pagina acompanhada e um no de uma treap
+ * ordenada pelo instante do ultimo acesso, entao a distancia (paginas distintas acessadas depois) sai em O(log n)
+ */
+struct StackAnalyzer{
+    // Nos da treap, indexados pelo mesmo indice da tabela de paginas
+    long long *time;
+    unsigned int *priority;
+    int *left;
+    int *right;
+    int *size;
+    long long *key; // pagina do no
+    int *hash; // hash espacial da pagina
+    int *heapIndex;
+    int capacity;
+    int numNodes;
+    int freeNode; // lista de nos livres encadeada por right
+    int root;
+
+    // Tabela hash com enderecamento aberto pagina -> no
+    long long *tableKeys;
+    int *tableNodes;
+    int tableCapacity;
+
+    // Heap maximo por hash das paginas amostradas, para reduzir o limiar no SHARDS de tamanho fixo
+    int *heap;
+    int heapSize;
+    int threshold;
+
+    double *histogram; // referencias por distancia de pilha (ja escalada pela taxa de amostragem)
+    int histogramSize;
+    double coldMisses;
+    double references;
+    long long clock;
+};
+
+extern void recordMrcReference(int pid, int page);
+extern void printMissRatioCurves();
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef __NUMA_H__
+#define __NUMA_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+// Latencia de um acesso ao no do proprio processo (ns)
+#define NUMA_LOCAL_LATENCY 90
+
+// Copia da pagina para o outro no e invalidacao da TLB (ns)
+#define NUMA_MIGRATION_TIME 10000
+
+#define NUMA_FIRST_TOUCH 0
+#define NUMA_INTERLEAVE 1
+#define NUMA_PREFERRED 2
+
+// No usado por todos os processos na alocacao preferencial
+#define NUMA_PREFERRED_NODE 0
+
+typedef struct NumaStatistics NumaStatistics;
+
+struct NumaStatistics{
+    long long localAccesses;
+    long long remoteAccesses;
+    long long nodeAccesses[MAX_NODES]; // acessos atendidos por cada no
+    long long allocations;
+    long long fallbacks; // frames alocados fora do no escolhido pela politica
+    long long migrations;
+    long long failedMigrations; // no do processo sem frame livre
+    long long accessTime; // ns
+};
+
+extern void createNuma();
+extern int homeNode(Process *process);
+extern int placePage(RAM *ram, Process *process, int pageNumber, int color);
+extern void recordNumaAccess(RAM *ram, Process *process, int pageNumber);
+extern void printNumaStatistics(RAM *ram, Process **processes, int count);
+
+#endif
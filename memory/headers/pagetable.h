@@ -0,0 +1,43 @@
+#ifndef __PAGETABLE_H__
+#define __PAGETABLE_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+
+// Tabela de paginas em arvore radix no estilo x86-64: cada nivel indexa PAGE_TABLE_BITS bits da pagina virtual
+#define PAGE_TABLE_BITS 9
+#define PAGE_TABLE_FANOUT (1 << PAGE_TABLE_BITS)
+#define VIRTUAL_ADDRESS_BITS 48
+#define MAX_PAGE_TABLE_LEVELS 8
+
+typedef struct PageTable PageTable;
+typedef struct PageTableNode PageTableNode;
+typedef struct PageTableLeaf PageTableLeaf;
+
+// Tabela intermediaria: aponta para as tabelas do nivel abaixo (NULL se ainda nao alocada)
+struct PageTableNode{
+    int used;
+    void *children[PAGE_TABLE_FANOUT];
+};
+
+// Tabela do ultimo nivel: frame de cada pagina (-1 se fora da memoria)
+struct PageTableLeaf{
+    int used;
+    int frames[PAGE_TABLE_FANOUT];
+};
+
+struct PageTable{
+    void *root;
+    int mapped;
+};
+
+extern int pageTableDepth();
+extern PageTable* createPageTable();
+extern int lookupPageTable(PageTable *table, long long virtualPage);
+extern void mapPage(PageTable *table, long long virtualPage, int frame);
+extern void unmapPage(PageTable *table, long long virtualPage);
+extern void printPageTable(PageTable *table, int hexadecimal);
+extern void mergePageTableStatistics();
+extern void printPageTableStatistics();
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef __PARALLEL_H__
+#define __PARALLEL_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+#include <pthread.h>
+
+#define MAX_THREADS 64
+
+// Frames guardados por thread e quantos sao trazidos da pilha global de uma vez
+#define FRAME_CACHE_SIZE 64
+#define FRAME_REFILL 16
+
+// Frames devolvidos a cada epoca de recuperacao, divididos entre as threads
+#define RECLAIM_BATCH 16
+
+// Fim da pilha de frames livres
+#define NO_FRAME 0xFFFFFFFFu
+
+typedef struct FramePool FramePool;
+typedef struct Worker Worker;
+typedef struct WorkerStatistics WorkerStatistics;
+
+/*
+ * Pilha de Treiber de frames livres: a cabeca junta o indice do frame do topo (32 bits baixos) e uma
+ * versao incrementada a cada troca (32 bits altos), o que evita o problema ABA com CAS de 64 bits
+ */
+struct FramePool{
+    unsigned long long head;
+    unsigned int *next; // proximo frame livre abaixo de cada frame
+    long long epoch; // epoca de recuperacao pedida pelas threads sem frames
+};
+
+struct WorkerStatistics{
+    long long references;
+    long long hits;
+    long long pageFaults;
+    long long replacements;
+    long long refills; // lotes trazidos da pilha global
+    long long casRetries; // CAS repetidos por disputa na pilha global
+    long long reclaimRequests;
+    long long reclaimedFrames;
+    long long waits; // voltas esperando frames de outras threads
+};
+
+struct Worker{
+    int id;
+    pthread_t thread;
+    Process **processes; // processos desta thread (process->pid % THREADS == id)
+    int numProcesses;
+    int reclaimCursor;
+
+    unsigned int cache[FRAME_CACHE_SIZE];
+    int cached;
+    long long seenEpoch;
+
+    WorkerStatistics statistics;
+} __attribute__((aligned(64)));
+
+extern void simulateParallel(Process **processes);
+
+#endif
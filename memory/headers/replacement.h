@@ -0,0 +1,77 @@
+#ifndef __REPLACEMENT_H__
+#define __REPLACEMENT_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+// Politicas de substituicao de paginas
+#define POLICY_LRU 0
+#define POLICY_FIFO 1
+#define POLICY_CLOCK 2
+#define POLICY_CLOCK_PRO 3
+#define POLICY_LFU 4
+#define POLICY_2Q 5
+#define POLICY_ARC 6
+#define POLICY_OPT 7
+#define POLICY_WORKING_SET 8
+#define NUM_POLICIES 9
+
+// Referencias entre cada envelhecimento dos contadores do LFU
+#define LFU_AGING_PERIOD 256
+
+// Janela de referencias futuras conhecidas pelo OPT sem trace
+#define OPT_LOOKAHEAD 4096
+
+// Bits do registrador de envelhecimento de cada pagina no modelo de working set
+#define WS_AGING_BITS 8
+
+// Menor bloco de elementos alocado pelo pool das listas de paginas (compilar com -DNO_PAGE_POOL usa malloc/free por elemento)
+#define PAGE_POOL_MIN_CHUNK 64
+
+typedef struct ReplacementPolicy ReplacementPolicy;
+typedef struct PageList PageList;
+
+// Interface das politicas: o estado de cada processo fica em WS.policyState
+struct ReplacementPolicy{
+    char *name;
+    void* (*create)(Process *process);
+    void (*onHit)(void *state, int page);
+    void (*onMiss)(void *state, int page); // pagina passa a estar no working set
+    int (*chooseVictim)(void *state, int incomingPage); // retira a vitima do estado e retorna sua pagina (incomingPage -1 se nao houver)
+    int (*nextReference)(void *state); // fonte de referencias propria (NULL usa nextProcessPage)
+    int (*nextExpired)(void *state); // retira do estado a proxima pagina que saiu do working set (-1 se nenhuma, NULL se o working set tem tamanho fixo)
+    void (*resize)(void *state, int limit); // novo limite de paginas residentes do processo, alterado pelo PFF (NULL se a politica nao depende dele)
+};
+
+// Lista duplamente encadeada de paginas, com indice pagina -> elemento compartilhado entre as listas
+struct PageList{
+    PageElement *head;
+    PageElement *tail;
+    int size;
+};
+
+extern ReplacementPolicy* replacementPolicy();
+extern int nextReferencedPage(Process *process);
+extern int workingSetSize(Process *process);
+
+extern void initPageList(PageList *list);
+extern PageElement* pushPage(PageList *list, PageElement **nodes, int page, int tag);
+extern void unlinkPage(PageList *list, PageElement *element);
+extern void appendPage(PageList *list, PageElement *element);
+extern int popPage(PageList *list, PageElement **nodes);
+extern void dropPage(PageList *list, PageElement **nodes, int page);
+extern PageElement** createNodeIndex();
+
+extern ReplacementPolicy lruPolicy;
+extern ReplacementPolicy fifoPolicy;
+extern ReplacementPolicy clockPolicy;
+extern ReplacementPolicy lfuPolicy;
+extern ReplacementPolicy clockProPolicy;
+extern ReplacementPolicy twoQueuePolicy;
+extern ReplacementPolicy arcPolicy;
+extern ReplacementPolicy optPolicy;
+extern ReplacementPolicy windowedOptPolicy;
+extern ReplacementPolicy workingSetPolicy;
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __SHARING_H__
+#define __SHARING_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+typedef struct SharedLibrary SharedLibrary;
+typedef struct SharingStatistics SharingStatistics;
+
+/*
+ * Biblioteca compartilhada somente leitura: as paginas 0 a SHARED_PAGES-1 de todos os processos mapeiam
+ * a mesma pagina do arquivo. As paginas ficam no page cache (que tambem conta uma referencia do frame)
+ * fora do working set dos processos, e o mapa reverso guarda, para cada pagina, os processos cujas
+ * tabelas de paginas a mapeiam, para retira-la de todos de uma vez
+ */
+struct SharedLibrary{
+    int *frames; // frame de cada pagina da biblioteca (-1 se fora do page cache)
+    unsigned int *mappers; // mapa reverso: bit pid ligado se o processo mapeia a pagina
+    char *referenced; // segunda chance na recuperacao
+    int hand;
+    int resident;
+};
+
+struct SharingStatistics{
+    long long forks;
+    long long inheritedPages; // paginas mapeadas no filho pelo fork
+    long long cowCopies; // escritas que copiaram a pagina para um frame proprio
+    long long cowReuses; // escritas em pagina que ja nao era compartilhada por ninguem
+    long long libraryHits;
+    long long libraryMinorFaults; // pagina ja no page cache, so mapeada no processo
+    long long libraryMajorFaults; // pagina trazida para o page cache
+    long long libraryReclaims;
+    long long rmapUnmaps; // mapeamentos desfeitos pelo mapa reverso
+};
+
+extern void createSharedLibrary();
+extern int isSharedPage(int pageNumber);
+extern int sharedPageFrame(int pageNumber);
+extern void insertSharedPage(int pageNumber, int frame);
+extern void mapSharedPage(Process *process, int pageNumber, RAM *ram);
+extern void touchSharedPage(int pageNumber, int fault, int cached);
+extern int reclaimSharedPage(Process **processes, RAM *ram);
+extern Process* forkProcess(Process *parent, int pid, RAM *ram);
+extern void recordCopyOnWrite(int copied);
+extern void printSharingStatistics(RAM *ram);
+
+#endif
@@ -3,15 +3,22 @@
 
 #include "../headers/globals.h"
 #include "../headers/memory_arguments.h"
+#include "../headers/pagetable.h"
+#include "../headers/generator.h"
 
 typedef struct PageElement PageElement;
 typedef struct Process Process;
 typedef struct WS WS;
 typedef struct RAM RAM;
+typedef struct MemoryNode MemoryNode;
+typedef struct FrameBin FrameBin;
 typedef struct PageValues PageValues;
+typedef struct Statistics Statistics;
+typedef struct PageMap PageMap;
 
 struct PageElement{
     int pageNumber;
+    int list; // lista em que a pagina esta, nas politicas com varias listas
     struct PageElement *prev;
     struct PageElement *next;
 };
@@ -22,19 +29,62 @@ struct Process{
     int status;
     int priority;
 
+    // Janela de medicao da taxa de faltas (PFF)
+    long long windowReferences;
+    long long windowFaults;
+    double faultRate; // taxa de faltas da ultima janela completa
+
     WS *workingSet;
+    PageMap *pageMap; // traducao das paginas virtuais do trace (NULL sem trace)
+    Generator *generator; // referencias sinteticas do processo (NULL com trace)
+};
+
+// Tabela hash com enderecamento aberto de pagina virtual -> pagina do processo (0 a NUM_PAGES-1)
+struct PageMap{
+    long long *keys;
+    int *values;
+    int capacity; // potencia de 2
+    long long *virtualPages; // pagina virtual de cada pagina do processo
+    int size;
 };
 
 struct WS{
-    PageElement *head;
-    PageElement *tail;
+    int limit; // paginas residentes permitidas
+    int remainingSlots;
+    PageTable *pageTable; // frame de cada pagina virtual no WS, alocada sob demanda
+    void *policyState; // estado da politica de substituicao do processo
+};
+
+// Bitmap de frames livres em varios niveis: cada bit de um nivel indica se a palavra
+// correspondente do nivel abaixo possui algum frame livre. O nivel 0 tem um bit por frame
+#define FRAME_BITMAP_LEVELS 6
+
+// Frames first, first+stride, first+2*stride... com o seu proprio bitmap de frames livres
+struct FrameBin{
+    unsigned long long *freeFrames[FRAME_BITMAP_LEVELS];
+    int levelWords[FRAME_BITMAP_LEVELS];
+    int numLevels;
+    int first;
+    int stride;
+    int frames;
+    int remainingSlots;
+};
+
+// No de memoria com os frames base a base+frames-1, separados por cor de cache (frame % numColors)
+struct MemoryNode{
+    FrameBin *bins; // um por cor
+    int base;
+    int frames;
     int remainingSlots;
-    int rows[MAX_PAGES];
 };
 
+// Sem NUMA a memoria tem um unico no, e sem coloracao de paginas uma unica cor
 struct RAM{
-    int addresses[MAX_FRAMES];
+    MemoryNode nodes[MAX_NODES];
+    int numNodes;
+    int numColors;
     int remainingSlots;
+    unsigned char *refCount; // mapeamentos de cada frame, so com paginas compartilhadas ou fork; o frame so volta ao bitmap quando chega a zero
 };
 
 struct PageValues{
@@ -42,13 +92,39 @@ struct PageValues{
     int address;
 };
 
+// Contadores agregados da simulacao
+struct Statistics{
+    long long cycles;
+    long long references;
+    long long hits;
+    long long pageFaults;
+    long long replacements; // faltas resolvidas trocando uma pagina do proprio WS
+    long long processRemovals; // processos retirados da memoria por falta de frames
+    long long writes;
+    long long expiredPages; // paginas liberadas por sairem da janela do working set
+    long long suspensions; // processos suspensos pelo controle de carga
+    long long resumes;
+    long long swappedPages; // paginas retiradas da memoria nas suspensoes
+    long long donatedFrames; // frames cedidos por processos com poucas faltas
+    long long residentGrows;
+    long long residentShrinks;
+};
+
 extern int readPageFromWorkingSet(Process *process, int pageNumber);
+extern int translatePage(Process *process, long long virtualPage);
+extern int nextProcessPage(Process *process);
+extern long long virtualPageOf(Process *process, int pageNumber);
 extern Process* createProcess(int pid);
 extern RAM* createRam();
+extern void resizeResidentSet(Process *process, int delta);
 extern void addPageToWorkingSet(Process *process, int pageNumber, int address);
-extern PageValues removeLeastUsedPage(Process *process);
+extern PageValues removeVictimPage(Process *process, int incomingPage);
+extern PageValues removeExpiredPage(Process *process);
 extern void removePageFromRAM(RAM *ram, int page);
 extern int addPageToRAM(RAM *ram);
+extern int addPageToNode(RAM *ram, int node, int color);
+extern int nodeOfFrame(RAM *ram, int frame);
+extern int frameMappings(RAM *ram, int frame);
 extern int isRAMFull(RAM *ram);
 extern int isWSEmpty(Process *process);
 extern void printTLB(Process *process);
@@ -0,0 +1,55 @@
+#ifndef __SWAP_H__
+#define __SWAP_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+
+// Tempo simulado de uma referencia sem falta, em nanossegundos
+#define REFERENCE_TIME 100
+
+#define MAX_SWAP_QUEUE 64
+
+// Faixas de 1 us do histograma de latencia das faltas; a ultima junta as latencias maiores
+#define LATENCY_BUCKETS 4096
+
+typedef struct SwapDevice SwapDevice;
+typedef struct SwapSpace SwapSpace;
+typedef struct SwapStatistics SwapStatistics;
+
+// Dispositivo com SWAP_QUEUE_DEPTH pedidos em andamento; cada posicao da fila atende um pedido por vez
+struct SwapDevice{
+    long long busyUntil[MAX_SWAP_QUEUE]; // fim do ultimo pedido de cada posicao (ns)
+    long long clock; // tempo simulado (ns)
+};
+
+// Estado das paginas de um processo em relacao ao swap
+struct SwapSpace{
+    unsigned long long *dirty; // escritas desde que entraram na memoria
+    unsigned long long *swapped; // com copia valida no swap
+    long long *readyAt; // fim da leitura antecipada, no swap cache (-1 se nenhuma)
+    int lastFault; // pagina da ultima falta, para detectar faltas sequenciais
+};
+
+struct SwapStatistics{
+    long long references;
+    long long compressedHits; // faltas resolvidas pelo pool comprimido
+    long long majorFaults; // lidas do dispositivo
+    long long minorFaults; // primeira referencia ou pagina limpa sem copia no swap
+    long long readaheadHits; // faltas resolvidas pela leitura antecipada
+    long long readaheadPages;
+    long long writebacks;
+    long long cleanEvictions;
+    long long queueWaits; // pedidos que esperaram uma posicao livre na fila
+    long long faultTime; // soma das latencias de servico das faltas (ns)
+    long long maxFaultTime;
+    long long histogram[LATENCY_BUCKETS];
+};
+
+extern void createSwapDevice();
+extern void recordSwapReference(Process *process, int pageNumber, int write, int fault);
+extern void swapOutPage(int pid, int pageNumber);
+extern void writeSwapPage(int pid, int pageNumber);
+extern void printSwapStatistics();
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef __TLB_H__
+#define __TLB_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+
+// Politicas de substituicao das entradas de um conjunto da TLB
+#define TLB_LRU 0
+#define TLB_FIFO 1
+#define TLB_RANDOM 2
+
+// Custos em ciclos usados no tempo efetivo de acesso
+#define TLB_L1_LATENCY 1
+#define TLB_L2_LATENCY 7
+#define MEMORY_LATENCY 100
+
+// Nivel da TLB que resolveu a traducao
+#define TLB_MISS 0
+#define TLB_L1_HIT 1
+#define TLB_L2_HIT 2
+
+typedef struct TLBLevel TLBLevel;
+typedef struct TLBStatistics TLBStatistics;
+
+// Um nivel associativo por conjunto: a entrada (conjunto, via) fica em set * ways + way
+struct TLBLevel{
+    int sets;
+    int ways;
+    long long *pages; // pagina de cada entrada (-1 se invalida)
+    int *asids; // processo dono da entrada
+    long long *stamps; // ultimo uso (LRU) ou instante de insercao (FIFO)
+    long long clock;
+};
+
+struct TLBStatistics{
+    long long lookups;
+    long long l1Hits;
+    long long l2Hits;
+    long long pageWalks;
+    long long flushes; // trocas de processo sem ASID
+    long long invalidations; // entradas derrubadas por paginas retiradas da memoria
+    long long cycles;
+};
+
+extern void createTLB();
+extern int accessTLB(int asid, int page);
+extern void invalidateTLBEntry(int asid, int page);
+extern void printTLBStatistics();
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+
+// Cabecalho do formato binario, seguido de registros TraceRecord
+#define TRACE_MAGIC "MEMTRACE"
+#define TRACE_MAGIC_SIZE 8
+
+// Bits de TraceRecord.flags
+#define TRACE_WRITE 1
+
+// Proximo uso de uma referencia cuja pagina nao e usada de novo pelo processo
+#define NO_NEXT_USE -1
+
+typedef struct TraceRecord TraceRecord;
+typedef struct TraceCursor TraceCursor;
+typedef struct TraceReference TraceReference;
+
+// Registro do formato binario (16 bytes, ordem de bytes da maquina)
+struct TraceRecord{
+    unsigned int pid;
+    unsigned int flags;
+    unsigned long long address;
+};
+
+// Posicao de leitura sobre o trace mapeado em memoria
+struct TraceCursor{
+    size_t offset;
+    size_t released; // inicio da regiao ainda nao devolvida ao kernel
+};
+
+// Referencia decodificada: processo (indice na ordem de aparicao), pagina virtual e escrita
+struct TraceReference{
+    int process;
+    long long page;
+    int offset; // deslocamento dentro da pagina
+    int write;
+};
+
+extern void openTrace(char *path);
+extern void indexTraceNextUses();
+extern int nextTraceReference(TraceReference *reference);
+extern long long currentTracePage();
+extern long long nextTraceUse();
+
+#endif
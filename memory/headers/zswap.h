@@ -0,0 +1,43 @@
+#ifndef __ZSWAP_H__
+#define __ZSWAP_H__
+
+#include "../headers/globals.h"
+#include "../headers/memory_arguments.h"
+#include "../headers/structures.h"
+#include "../headers/replacement.h"
+
+// Tempo de CPU para comprimir uma pagina ao guarda-la no pool e para descomprimi-la na falta, em nanossegundos
+#define ZSWAP_COMPRESS_TIME 4000
+#define ZSWAP_DECOMPRESS_TIME 1500
+
+typedef struct ZswapPool ZswapPool;
+typedef struct ZswapStatistics ZswapStatistics;
+
+/*
+ * Pool comprimido entre a memoria e o swap: ZSWAP_PERCENT dos frames sao reservados e as paginas
+ * sujas retiradas da memoria sao guardadas comprimidas. O pool tem um LRU proprio com as paginas de
+ * todos os processos (o pid fica no campo list do elemento); quando enche, as mais antigas sao
+ * gravadas no swap
+ */
+struct ZswapPool{
+    int frames;
+    long long capacity; // bytes
+    long long used;
+    PageList lru;
+    PageElement **nodes[MAX_PROCESSES]; // indice pagina -> elemento de cada processo
+};
+
+struct ZswapStatistics{
+    long long stores;
+    long long rejects; // paginas incompressiveis, gravadas direto no swap
+    long long loads; // faltas resolvidas pelo pool
+    long long spills; // paginas mais antigas do pool gravadas no swap
+    long long storedBytes; // soma dos tamanhos comprimidos guardados
+};
+
+extern void createZswapPool(RAM *ram);
+extern int storeCompressedPage(int pid, int pageNumber);
+extern int loadCompressedPage(int pid, int pageNumber);
+extern void printZswapStatistics();
+
+#endif
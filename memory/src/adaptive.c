@@ -0,0 +1,468 @@
+#include "../headers/replacement.h"
+
+// Listas do 2Q e do ARC
+#define LIST_A1_IN 1
+#define LIST_A1_OUT 2
+#define LIST_AM 3
+#define LIST_T1 1
+#define LIST_B1 2
+#define LIST_T2 3
+#define LIST_B2 4
+
+// Estados das paginas no Clock-Pro
+#define CP_NONE 0
+#define CP_HOT 1
+#define CP_COLD 2
+#define CP_NONRESIDENT 3
+
+typedef struct TwoQueueState TwoQueueState;
+typedef struct ArcState ArcState;
+typedef struct ClockProState ClockProState;
+
+// 2Q: A1in (FIFO de paginas novas), A1out (historico sem frame) e Am (LRU de paginas quentes)
+struct TwoQueueState{
+    PageList a1in;
+    PageList a1out;
+    PageList am;
+    PageElement **nodes;
+    int kin;
+    int kout;
+};
+
+// ARC: T1/T2 residentes (vistas uma vez / mais de uma vez) e B1/B2 seus historicos sem frame
+struct ArcState{
+    PageList t1;
+    PageList b1;
+    PageList t2;
+    PageList b2;
+    PageElement **nodes;
+    int capacity; // c: limite de paginas residentes do processo
+    int target; // tamanho alvo de T1
+    int prepared; // pagina cuja chegada ja ajustou o alvo em chooseVictim
+};
+
+// Clock-Pro: um relogio com paginas quentes, frias e frias sem frame em periodo de teste
+struct ClockProState{
+    int *next; // lista circular encadeada pelas paginas
+    int *prev;
+    char *status;
+    char *referenced;
+    char *inTest;
+    int handHot;
+    int handCold;
+    int handTest;
+    int numHot;
+    int numCold;
+    int numNonResident;
+    int coldTarget; // quantidade alvo de paginas frias residentes
+    int limit; // limite de paginas residentes do processo
+};
+
+void* createTwoQueueState(Process *process);
+void twoQueueHit(void *state, int page);
+void twoQueueMiss(void *state, int page);
+int twoQueueVictim(void *state, int incomingPage);
+void twoQueueResize(void *state, int limit);
+void* createArcState(Process *process);
+void arcTrimHistory(ArcState *arc);
+int arcPrepare(ArcState *arc, int page);
+int arcReplace(ArcState *arc, int incomingInB2);
+void arcHit(void *state, int page);
+void arcMiss(void *state, int page);
+int arcVictim(void *state, int incomingPage);
+void arcResize(void *state, int limit);
+void* createClockProState(Process *process);
+void clockProInsert(ClockProState *cp, int page);
+void clockProRemove(ClockProState *cp, int page);
+void clockProRunHot(ClockProState *cp);
+void clockProRunTest(ClockProState *cp);
+void clockProHit(void *state, int page);
+void clockProMiss(void *state, int page);
+int clockProVictim(void *state, int incomingPage);
+void clockProResize(void *state, int limit);
+
+ReplacementPolicy twoQueuePolicy = {"2Q", createTwoQueueState, twoQueueHit, twoQueueMiss, twoQueueVictim, NULL, NULL, twoQueueResize};
+ReplacementPolicy arcPolicy = {"ARC", createArcState, arcHit, arcMiss, arcVictim, NULL, NULL, arcResize};
+ReplacementPolicy clockProPolicy = {"Clock-Pro", createClockProState, clockProHit, clockProMiss, clockProVictim, NULL, NULL, clockProResize};
+
+/* ===== 2Q ===== */
+
+void* createTwoQueueState(Process *process){
+    TwoQueueState *twoQueue = (TwoQueueState *)malloc(sizeof(TwoQueueState));
+    if(twoQueue == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    initPageList(&twoQueue->a1in);
+    initPageList(&twoQueue->a1out);
+    initPageList(&twoQueue->am);
+    twoQueue->nodes = createNodeIndex();
+    twoQueueResize(twoQueue, process->workingSet->limit);
+    return twoQueue;
+}
+
+void twoQueueHit(void *state, int page){
+    TwoQueueState *twoQueue = (TwoQueueState *)state;
+    PageElement *element = twoQueue->nodes[page];
+
+    // Acertos no A1in nao promovem: referencias correlacionadas logo apos a chegada sao ignoradas
+    if(element->list != LIST_AM) return;
+    unlinkPage(&twoQueue->am, element);
+    appendPage(&twoQueue->am, element);
+}
+
+void twoQueueMiss(void *state, int page){
+    TwoQueueState *twoQueue = (TwoQueueState *)state;
+    PageElement *element = twoQueue->nodes[page];
+
+    // Pagina lembrada no A1out voltou: e quente
+    if(element){
+        unlinkPage(&twoQueue->a1out, element);
+        element->list = LIST_AM;
+        appendPage(&twoQueue->am, element);
+        return;
+    }
+    pushPage(&twoQueue->a1in, twoQueue->nodes, page, LIST_A1_IN);
+}
+
+int twoQueueVictim(void *state, int incomingPage){
+    TwoQueueState *twoQueue = (TwoQueueState *)state;
+    if(twoQueue->a1in.size <= twoQueue->kin && twoQueue->am.size) return popPage(&twoQueue->am, twoQueue->nodes);
+
+    // A vitima do A1in continua lembrada no A1out
+    PageElement *element = twoQueue->a1in.head;
+    unlinkPage(&twoQueue->a1in, element);
+    element->list = LIST_A1_OUT;
+    appendPage(&twoQueue->a1out, element);
+    while(twoQueue->a1out.size > twoQueue->kout) popPage(&twoQueue->a1out, twoQueue->nodes);
+
+    return element->pageNumber;
+}
+
+/**
+ * @brief Tamanhos sugeridos pelos autores: A1in com 25% dos frames do processo e A1out com 50%
+ */
+void twoQueueResize(void *state, int limit){
+    TwoQueueState *twoQueue = (TwoQueueState *)state;
+    twoQueue->kin = limit / 4 > 0 ? limit / 4 : 1;
+    twoQueue->kout = limit / 2 > 0 ? limit / 2 : 1;
+}
+
+/* ===== ARC ===== */
+
+void* createArcState(Process *process){
+    ArcState *arc = (ArcState *)malloc(sizeof(ArcState));
+    if(arc == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    initPageList(&arc->t1);
+    initPageList(&arc->b1);
+    initPageList(&arc->t2);
+    initPageList(&arc->b2);
+    arc->nodes = createNodeIndex();
+    arc->capacity = process->workingSet->limit;
+    arc->target = 0;
+    arc->prepared = -1;
+    return arc;
+}
+
+/**
+ * @brief Mantem |T1| + |B1| <= c e o total <= 2c
+ */
+void arcTrimHistory(ArcState *arc){
+    int c = arc->capacity;
+    while(arc->t1.size + arc->b1.size > c && arc->b1.size) popPage(&arc->b1, arc->nodes);
+    while(arc->t1.size + arc->t2.size + arc->b1.size + arc->b2.size > 2 * c && arc->b2.size) popPage(&arc->b2, arc->nodes);
+}
+
+/**
+ * @brief Adapta o alvo de T1 para a chegada da pagina: um acerto em B1 pede mais recencia e em B2 mais frequencia
+ *
+ * @return int 1 se a pagina esta em B2
+ */
+int arcPrepare(ArcState *arc, int page){
+    int c = arc->capacity;
+    PageElement *element = page >= 0 ? arc->nodes[page] : NULL;
+
+    if(element && element->list == LIST_B1){
+        int delta = arc->b2.size / arc->b1.size > 1 ? arc->b2.size / arc->b1.size : 1;
+        arc->target = arc->target + delta < c ? arc->target + delta : c;
+        return 0;
+    }
+    if(element && element->list == LIST_B2){
+        int delta = arc->b1.size / arc->b2.size > 1 ? arc->b1.size / arc->b2.size : 1;
+        arc->target = arc->target - delta > 0 ? arc->target - delta : 0;
+        return 1;
+    }
+
+    // Pagina nova: abre espaco no historico
+    if(page >= 0 && arc->t1.size + arc->b1.size >= c && arc->b1.size) popPage(&arc->b1, arc->nodes);
+    else if(page >= 0 && arc->t1.size + arc->t2.size + arc->b1.size + arc->b2.size >= 2 * c && arc->b2.size) popPage(&arc->b2, arc->nodes);
+    return 0;
+}
+
+/**
+ * @brief Retira a pagina menos recente de T1 ou de T2 de acordo com o alvo, lembrando-a no historico
+ */
+int arcReplace(ArcState *arc, int incomingInB2){
+    PageElement *element;
+    if(arc->t1.size && ((incomingInB2 && arc->t1.size == arc->target) || arc->t1.size > arc->target || !arc->t2.size)){
+        element = arc->t1.head;
+        unlinkPage(&arc->t1, element);
+        element->list = LIST_B1;
+        appendPage(&arc->b1, element);
+    }else{
+        element = arc->t2.head;
+        unlinkPage(&arc->t2, element);
+        element->list = LIST_B2;
+        appendPage(&arc->b2, element);
+    }
+
+    int page = element->pageNumber;
+    arcTrimHistory(arc);
+    return page;
+}
+
+void arcHit(void *state, int page){
+    ArcState *arc = (ArcState *)state;
+    PageElement *element = arc->nodes[page];
+
+    unlinkPage(element->list == LIST_T1 ? &arc->t1 : &arc->t2, element);
+    element->list = LIST_T2;
+    appendPage(&arc->t2, element);
+}
+
+void arcMiss(void *state, int page){
+    ArcState *arc = (ArcState *)state;
+    if(arc->prepared != page) arcPrepare(arc, page);
+    arc->prepared = -1;
+
+    // Pagina do historico volta direto para T2
+    PageElement *element = arc->nodes[page];
+    if(element){
+        unlinkPage(element->list == LIST_B1 ? &arc->b1 : &arc->b2, element);
+        element->list = LIST_T2;
+        appendPage(&arc->t2, element);
+        return;
+    }
+    pushPage(&arc->t1, arc->nodes, page, LIST_T1);
+}
+
+int arcVictim(void *state, int incomingPage){
+    ArcState *arc = (ArcState *)state;
+    int incomingInB2 = arcPrepare(arc, incomingPage);
+    arc->prepared = incomingPage;
+
+    // T1 ocupa todos os frames: a pagina sai sem ser lembrada
+    PageElement *element = incomingPage >= 0 ? arc->nodes[incomingPage] : NULL;
+    if(!element && arc->t1.size >= arc->capacity) return popPage(&arc->t1, arc->nodes);
+
+    return arcReplace(arc, incomingInB2);
+}
+
+/**
+ * @brief Acompanha o limite do processo: o alvo de T1 e o historico continuam dentro de c e 2c
+ */
+void arcResize(void *state, int limit){
+    ArcState *arc = (ArcState *)state;
+    arc->capacity = limit;
+    if(arc->target > limit) arc->target = limit;
+    arcTrimHistory(arc);
+}
+
+/* ===== Clock-Pro ===== */
+
+void* createClockProState(Process *process){
+    ClockProState *cp = (ClockProState *)malloc(sizeof(ClockProState));
+    if(cp == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    cp->next = (int *)malloc(sizeof(int) * NUM_PAGES);
+    cp->prev = (int *)malloc(sizeof(int) * NUM_PAGES);
+    cp->status = (char *)calloc(NUM_PAGES, sizeof(char));
+    cp->referenced = (char *)calloc(NUM_PAGES, sizeof(char));
+    cp->inTest = (char *)calloc(NUM_PAGES, sizeof(char));
+    if(!cp->next || !cp->prev || !cp->status || !cp->referenced || !cp->inTest){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    cp->handHot = cp->handCold = cp->handTest = -1;
+    cp->numHot = cp->numCold = cp->numNonResident = 0;
+    cp->limit = process->workingSet->limit;
+    cp->coldTarget = cp->limit / 4 > 0 ? cp->limit / 4 : 1;
+    return cp;
+}
+
+/**
+ * @brief Insere a pagina na cabeca do relogio, logo atras do ponteiro quente
+ */
+void clockProInsert(ClockProState *cp, int page){
+    if(cp->handHot == -1){
+        cp->next[page] = cp->prev[page] = page;
+        cp->handHot = cp->handCold = cp->handTest = page;
+        return;
+    }
+
+    int after = cp->handHot, before = cp->prev[after];
+    cp->next[before] = page;
+    cp->prev[page] = before;
+    cp->next[page] = after;
+    cp->prev[after] = page;
+}
+
+/**
+ * @brief Retira a pagina do relogio, avancando os ponteiros que apontam para ela
+ */
+void clockProRemove(ClockProState *cp, int page){
+    if(cp->next[page] == page){
+        cp->handHot = cp->handCold = cp->handTest = -1;
+        return;
+    }
+
+    if(cp->handHot == page) cp->handHot = cp->next[page];
+    if(cp->handCold == page) cp->handCold = cp->next[page];
+    if(cp->handTest == page) cp->handTest = cp->next[page];
+    cp->next[cp->prev[page]] = cp->next[page];
+    cp->prev[cp->next[page]] = cp->prev[page];
+}
+
+/**
+ * @brief Ponteiro quente: rebaixa uma pagina quente sem referencia e encerra os testes pelo caminho
+ */
+void clockProRunHot(ClockProState *cp){
+    while(cp->numHot){
+        int page = cp->handHot;
+        cp->handHot = cp->next[page];
+
+        if(cp->status[page] == CP_HOT){
+            if(cp->referenced[page]){
+                cp->referenced[page] = 0;
+                continue;
+            }
+            cp->status[page] = CP_COLD;
+            cp->inTest[page] = 0;
+            cp->numHot--;
+            cp->numCold++;
+            return;
+        }
+
+        if(!cp->inTest[page]) continue;
+        if(cp->coldTarget > 1) cp->coldTarget--;
+        cp->inTest[page] = 0;
+        if(cp->status[page] == CP_NONRESIDENT){
+            clockProRemove(cp, page);
+            cp->status[page] = CP_NONE;
+            cp->numNonResident--;
+        }
+    }
+}
+
+/**
+ * @brief Ponteiro de teste: encerra periodos de teste ate esquecer uma pagina sem frame
+ */
+void clockProRunTest(ClockProState *cp){
+    while(cp->numNonResident){
+        int page = cp->handTest;
+        cp->handTest = cp->next[page];
+        if(!cp->inTest[page]) continue;
+
+        if(cp->coldTarget > 1) cp->coldTarget--;
+        cp->inTest[page] = 0;
+        if(cp->status[page] == CP_NONRESIDENT){
+            clockProRemove(cp, page);
+            cp->status[page] = CP_NONE;
+            cp->numNonResident--;
+            return;
+        }
+    }
+}
+
+void clockProHit(void *state, int page){
+    ClockProState *cp = (ClockProState *)state;
+    cp->referenced[page] = 1;
+}
+
+void clockProMiss(void *state, int page){
+    ClockProState *cp = (ClockProState *)state;
+    int maxTarget = cp->limit > 1 ? cp->limit - 1 : 1;
+
+    cp->referenced[page] = 0;
+    if(cp->status[page] == CP_NONRESIDENT){
+        // Voltou durante o teste: a distancia de reuso e curta, entao a pagina e quente e as frias merecem mais espaco
+        if(cp->coldTarget < maxTarget) cp->coldTarget++;
+        clockProRemove(cp, page);
+        cp->numNonResident--;
+        clockProInsert(cp, page);
+        cp->status[page] = CP_HOT;
+        cp->inTest[page] = 0;
+        cp->numHot++;
+        while(cp->numHot > cp->limit - cp->coldTarget) clockProRunHot(cp);
+        return;
+    }
+
+    clockProInsert(cp, page);
+    cp->status[page] = CP_COLD;
+    cp->inTest[page] = 1;
+    cp->numCold++;
+}
+
+int clockProVictim(void *state, int incomingPage){
+    ClockProState *cp = (ClockProState *)state;
+
+    while(1){
+        if(!cp->numCold){
+            clockProRunHot(cp);
+            continue;
+        }
+
+        int page = cp->handCold;
+        cp->handCold = cp->next[page];
+        if(cp->status[page] != CP_COLD) continue;
+
+        if(cp->referenced[page]){
+            cp->referenced[page] = 0;
+            if(cp->inTest[page]){
+                // Referenciada durante o teste: vira quente
+                cp->status[page] = CP_HOT;
+                cp->inTest[page] = 0;
+                cp->numCold--;
+                cp->numHot++;
+                if(cp->numHot > cp->limit - cp->coldTarget) clockProRunHot(cp);
+            }else{
+                // Ganha um novo periodo de teste na cabeca do relogio
+                cp->inTest[page] = 1;
+                clockProRemove(cp, page);
+                clockProInsert(cp, page);
+            }
+            continue;
+        }
+
+        cp->numCold--;
+        if(cp->inTest[page]){
+            // Continua no relogio sem frame ate o fim do teste
+            cp->status[page] = CP_NONRESIDENT;
+            cp->numNonResident++;
+            if(cp->numNonResident > cp->limit) clockProRunTest(cp);
+        }else{
+            clockProRemove(cp, page);
+            cp->status[page] = CP_NONE;
+        }
+        return page;
+    }
+}
+
+/**
+ * @brief Acompanha o limite do processo: o alvo de frias fica abaixo dele e as quentes e as paginas em teste
+ * voltam para dentro dos novos tamanhos
+ */
+void clockProResize(void *state, int limit){
+    ClockProState *cp = (ClockProState *)state;
+    int maxTarget = limit > 1 ? limit - 1 : 1;
+
+    cp->limit = limit;
+    if(cp->coldTarget > maxTarget) cp->coldTarget = maxTarget;
+    while(cp->numHot && cp->numHot > cp->limit - cp->coldTarget) clockProRunHot(cp);
+    while(cp->numNonResident > cp->limit) clockProRunTest(cp);
+}
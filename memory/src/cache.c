@@ -0,0 +1,209 @@
+#include "../headers/cache.h"
+#include "../headers/pagetable.h"
+#if defined(__SSE2__) && !defined(NO_SIMD_TAGS)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) && !defined(NO_SIMD_TAGS)
+#include <immintrin.h>
+#endif
+
+CacheLevel *caches[3];
+long long cacheCycles = 0;
+
+// Geracao de cada frame, incrementada quando ele e liberado
+unsigned int *frameGenerations;
+
+void createCaches();
+CacheLevel* createCacheLevel(char *name, long long size, int ways);
+int isCacheGeometryValid(int llcKilobytes, int llcWays);
+int pageColors();
+int pageColor(Process *process, int pageNumber);
+int findCacheTag(CacheLevel *cache, int first, unsigned int tag);
+int lookupCacheLevel(CacheLevel *cache, long long line, unsigned int generation);
+void invalidateFrameCaches(int frame);
+void recordCacheAccess(Process *process, int pageNumber, int offset);
+void printCacheStatistics();
+
+void createCaches(){
+    caches[0] = createCacheLevel("L1", L1_CACHE_SIZE, L1_CACHE_WAYS);
+    caches[1] = createCacheLevel("L2", L2_CACHE_SIZE, L2_CACHE_WAYS);
+    caches[2] = createCacheLevel("LLC", CACHE_SIZE * 1024LL, CACHE_WAYS);
+
+    frameGenerations = (unsigned int *)calloc(FRAMES, sizeof(unsigned int));
+    if(!frameGenerations){
+        exit(PROCESS_CREATION_ERROR);
+    }
+}
+
+CacheLevel* createCacheLevel(char *name, long long size, int ways){
+    CacheLevel *cache = (CacheLevel *)malloc(sizeof(CacheLevel));
+    if(cache == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    cache->name = name;
+    cache->sets = size / (CACHE_LINE * ways);
+    cache->setBits = __builtin_ctz(cache->sets);
+    cache->ways = ways;
+    cache->tags = (unsigned int *)malloc(sizeof(unsigned int) * cache->sets * ways);
+    cache->stamps = (long long *)calloc((size_t)cache->sets * ways, sizeof(long long));
+    cache->generations = (unsigned int *)calloc((size_t)cache->sets * ways, sizeof(unsigned int));
+    if(!cache->tags || !cache->stamps || !cache->generations){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int line = 0; line < cache->sets * ways; line++) cache->tags[line] = CACHE_INVALID;
+    cache->clock = 0;
+    cache->accesses = 0;
+    cache->misses = 0;
+    return cache;
+}
+
+/**
+ * @brief A LLC precisa ser maior que a L2 e ter uma potencia de 2 de conjuntos, para indexar pelos bits do endereco
+ */
+int isCacheGeometryValid(int llcKilobytes, int llcWays){
+    long long size = llcKilobytes * 1024LL;
+    if(size <= L2_CACHE_SIZE || size % (CACHE_LINE * llcWays)) return 0;
+
+    long long sets = size / (CACHE_LINE * llcWays);
+    return (sets & (sets - 1)) == 0;
+}
+
+/**
+ * @brief Cores de pagina da LLC: paginas de cores diferentes nunca disputam os mesmos conjuntos
+ */
+int pageColors(){
+    long long wayBytes = CACHE_SIZE * 1024LL / CACHE_WAYS;
+    return wayBytes > VIRTUAL_PAGE_SIZE ? wayBytes / VIRTUAL_PAGE_SIZE : 1;
+}
+
+/**
+ * @brief Cor do frame da pagina na coloracao: a cor da pagina virtual, deslocada pelo pid para que as paginas
+ * iniciais dos processos nao fiquem todas nas mesmas cores
+ *
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @return int Cor
+ */
+int pageColor(Process *process, int pageNumber){
+    int colors = pageColors();
+    long long shift = (long long)process->pid * colors / PROCESSES;
+    return (virtualPageOf(process, pageNumber) + shift) % colors;
+}
+
+/**
+ * @brief Compara a tag com todas as vias do conjunto, de 8 ou 4 em 4 vias com SIMD quando disponivel
+ *
+ * @return int Indice da linha ou -1 se a tag nao esta no conjunto
+ */
+int findCacheTag(CacheLevel *cache, int first, unsigned int tag){
+    int way = 0;
+#if defined(__AVX2__) && !defined(NO_SIMD_TAGS)
+    __m256i key8 = _mm256_set1_epi32((int)tag);
+    for(; way + 8 <= cache->ways; way += 8){
+        __m256i tags = _mm256_loadu_si256((__m256i *)(cache->tags + first + way));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(tags, key8)));
+        if(mask) return first + way + __builtin_ctz(mask);
+    }
+#endif
+#if defined(__SSE2__) && !defined(NO_SIMD_TAGS)
+    __m128i key4 = _mm_set1_epi32((int)tag);
+    for(; way + 4 <= cache->ways; way += 4){
+        __m128i tags = _mm_loadu_si128((__m128i *)(cache->tags + first + way));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(tags, key4)));
+        if(mask) return first + way + __builtin_ctz(mask);
+    }
+#endif
+    for(; way < cache->ways; way++){
+        if(cache->tags[first + way] == tag) return first + way;
+    }
+    return -1;
+}
+
+/**
+ * @brief Procura a linha no conjunto dela; na falta, a linha substitui a via invalida ou a menos usada.
+ * Uma linha de uma geracao anterior do frame e de outra pagina, entao e uma falta que reaproveita a via
+ *
+ * @param cache Nivel da cache
+ * @param line Endereco fisico da linha (endereco / CACHE_LINE)
+ * @param generation Geracao atual do frame da linha
+ * @return int 1 se acertou
+ */
+int lookupCacheLevel(CacheLevel *cache, long long line, unsigned int generation){
+    int first = (int)(line & (cache->sets - 1)) * cache->ways;
+    unsigned int tag = (unsigned int)(line >> cache->setBits);
+    cache->accesses++;
+
+    int entry = findCacheTag(cache, first, tag);
+    if(entry != -1 && cache->generations[entry] == generation){
+        cache->stamps[entry] = ++cache->clock;
+        return 1;
+    }
+
+    cache->misses++;
+    if(entry != -1){
+        cache->generations[entry] = generation;
+        cache->stamps[entry] = ++cache->clock;
+        return 0;
+    }
+
+    int victim = first;
+    for(entry = first; entry < first + cache->ways; entry++){
+        if(cache->tags[entry] == CACHE_INVALID){
+            victim = entry;
+            break;
+        }
+        if(cache->stamps[entry] < cache->stamps[victim]) victim = entry;
+    }
+    cache->tags[victim] = tag;
+    cache->generations[victim] = generation;
+    cache->stamps[victim] = ++cache->clock;
+    return 0;
+}
+
+/**
+ * @brief Invalida as linhas do frame liberado em todos os niveis, para que a proxima pagina colocada nele
+ * nao acerte nas linhas da pagina anterior. A geracao do frame muda em O(1) e as linhas antigas sao
+ * descartadas quando forem encontradas
+ *
+ * @param frame Endereco do frame
+ */
+void invalidateFrameCaches(int frame){
+    frameGenerations[frame]++;
+}
+
+/**
+ * @brief Acessa pelas caches o endereco fisico da referencia, ja na memoria: L1, depois L2, LLC e a memoria.
+ * Cada nivel que falhou fica com a linha
+ *
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @param offset Deslocamento dentro da pagina
+ */
+void recordCacheAccess(Process *process, int pageNumber, int offset){
+    int frame = lookupPageTable(process->workingSet->pageTable, virtualPageOf(process, pageNumber));
+    if(frame == -1) return;
+
+    long long line = ((long long)frame * VIRTUAL_PAGE_SIZE + offset) / CACHE_LINE;
+    int latencies[] = {L1_CACHE_LATENCY, L2_CACHE_LATENCY, LLC_LATENCY};
+    for(int level = 0; level < 3; level++){
+        cacheCycles += latencies[level];
+        if(lookupCacheLevel(caches[level], line, frameGenerations[frame])) return;
+    }
+    cacheCycles += DRAM_LATENCY;
+}
+
+/**
+ * @brief Imprime a taxa de faltas local de cada nivel e a fracao das referencias que chegou a memoria
+ */
+void printCacheStatistics(){
+    long long references = caches[0]->accesses ? caches[0]->accesses : 1;
+
+    printf("-> Caches (linha de %d bytes, %s, %d cores de pagina):", CACHE_LINE, PAGE_COLORING ? "coloracao de paginas" : "primeiro frame livre", pageColors());
+    for(int level = 0; level < 3; level++){
+        CacheLevel *cache = caches[level];
+        printf(" %s %lld KB/%d vias com %.2f%% de faltas%s", cache->name, (long long)cache->sets * cache->ways * CACHE_LINE / 1024, cache->ways, cache->accesses ? 100.0 * cache->misses / cache->accesses : 0, level < 2 ? "," : "\n");
+    }
+    printf("-> Acessos a memoria: %lld (%.2f%% das referencias), tempo medio de acesso: %.2f ciclos\n", caches[2]->misses, 100.0 * caches[2]->misses / references, (double)cacheCycles / references);
+}
@@ -0,0 +1,208 @@
+#include "../headers/generator.h"
+#include <math.h>
+
+ZipfTable *zipfTable = NULL;
+
+unsigned long long generatorSeed();
+unsigned long long splitMix(unsigned long long *x);
+Generator* createGenerator(int pid);
+unsigned long long nextRandom(Generator *generator);
+int randomBelow(Generator *generator, int bound);
+ZipfTable* createZipfTable();
+int zipfPage(Generator *generator);
+int nextGeneratedPage(Generator *generator);
+int nextGeneratedWrite(Generator *generator);
+int nextGeneratedOffset(Generator *generator);
+
+/**
+ * @brief Semente da simulacao: a passada com -o ou o relogio
+ *
+ * @return unsigned long long Semente
+ */
+unsigned long long generatorSeed(){
+    static unsigned long long seed = 0;
+    if(!seed) seed = SEED ? (unsigned long long)SEED : (unsigned long long)time(NULL);
+    return seed;
+}
+
+unsigned long long splitMix(unsigned long long *x){
+    unsigned long long z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Cria o gerador do processo, com um fluxo derivado da semente e do pid
+ *
+ * @param pid Id do processo
+ * @return Generator* Gerador
+ */
+Generator* createGenerator(int pid){
+    Generator *generator = (Generator *)malloc(sizeof(Generator));
+    if(generator == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    unsigned long long x = generatorSeed() ^ (unsigned long long)pid * 0xD1B54A32D192ED03ULL;
+    for(int i = 0; i < 4; i++) generator->state[i] = splitMix(&x);
+
+    generator->pattern = PATTERN;
+    generator->pages = NUM_PAGES;
+    generator->references = 0;
+    generator->position = 0;
+    generator->phaseStart = 0;
+    if(PATTERN == PATTERN_ZIPF || PATTERN == PATTERN_SCAN){
+        if(!zipfTable) zipfTable = createZipfTable();
+    }
+    return generator;
+}
+
+/**
+ * @brief Proximo numero do xoshiro256**
+ */
+unsigned long long nextRandom(Generator *generator){
+    unsigned long long *s = generator->state;
+    unsigned long long result = s[1] * 5;
+    result = (result << 7 | result >> 57) * 9;
+
+    unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = s[3] << 45 | s[3] >> 19;
+    return result;
+}
+
+/**
+ * @brief Numero uniforme em [0, bound) por multiplicacao, sem divisao
+ */
+int randomBelow(Generator *generator, int bound){
+    return (int)((nextRandom(generator) >> 32) * (unsigned long long)bound >> 32);
+}
+
+/**
+ * @brief Monta a tabela de alias da distribuicao de Zipf P(k) ~ 1 / (k+1)^s, com s = ZIPF_EXPONENT / 100,
+ * para sortear uma pagina em O(1)
+ *
+ * @return ZipfTable* Tabela
+ */
+ZipfTable* createZipfTable(){
+    ZipfTable *table = (ZipfTable *)malloc(sizeof(ZipfTable));
+    double *weights = (double *)malloc(sizeof(double) * NUM_PAGES);
+    double *probability = (double *)malloc(sizeof(double) * NUM_PAGES);
+    int *small = (int *)malloc(sizeof(int) * NUM_PAGES);
+    int *large = (int *)malloc(sizeof(int) * NUM_PAGES);
+    if(!table || !weights || !probability || !small || !large){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    table->columns = (ZipfColumn *)malloc(sizeof(ZipfColumn) * NUM_PAGES);
+    if(!table->columns){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    double total = 0;
+    for(int k = 0; k < NUM_PAGES; k++){
+        weights[k] = pow(k + 1, -ZIPF_EXPONENT / 100.0);
+        total += weights[k];
+    }
+
+    // Cada coluna recebe peso medio 1: as leves sao completadas por uma pesada, que vira o alias
+    int numSmall = 0, numLarge = 0;
+    for(int k = 0; k < NUM_PAGES; k++){
+        weights[k] = weights[k] * NUM_PAGES / total;
+        if(weights[k] < 1) small[numSmall++] = k;
+        else large[numLarge++] = k;
+    }
+    while(numSmall && numLarge){
+        int light = small[--numSmall];
+        int heavy = large[numLarge - 1];
+
+        probability[light] = weights[light];
+        table->columns[light].alias = heavy;
+        weights[heavy] -= 1 - weights[light];
+        if(weights[heavy] < 1){
+            numLarge--;
+            small[numSmall++] = heavy;
+        }
+    }
+    while(numLarge) probability[large[--numLarge]] = 1;
+    while(numSmall) probability[small[--numSmall]] = 1;
+    for(int k = 0; k < NUM_PAGES; k++){
+        // Colunas cheias apontam para si mesmas, entao o limiar nao precisa representar 1
+        if(probability[k] >= 1) table->columns[k].alias = k;
+        table->columns[k].threshold = probability[k] >= 1 ? 0xFFFFFFFFu : (unsigned int)(probability[k] * 4294967296.0);
+    }
+
+    free(weights);
+    free(probability);
+    free(small);
+    free(large);
+    return table;
+}
+
+int zipfPage(Generator *generator){
+    unsigned long long r = nextRandom(generator);
+    int column = (int)((r >> 32) * (unsigned long long)generator->pages >> 32);
+    ZipfColumn entry = zipfTable->columns[column];
+
+    // Escolha sem desvio: o sorteio da coluna nao e previsivel
+    int stay = (unsigned int)r < entry.threshold;
+    return entry.alias ^ ((column ^ entry.alias) & -stay);
+}
+
+/**
+ * @brief Proxima pagina do processo no padrao escolhido com -g
+ *
+ * @param generator Gerador do processo
+ * @return int Pagina
+ */
+int nextGeneratedPage(Generator *generator){
+    long long reference = generator->references++;
+
+    switch(generator->pattern){
+        case PATTERN_ZIPF:
+            return zipfPage(generator);
+        case PATTERN_SCAN: {
+            // Conjunto quente de Zipf interrompido por varreduras sequenciais de todas as paginas
+            long long offset = reference % (SCAN_HOT_LENGTH + generator->pages);
+            return offset < SCAN_HOT_LENGTH ? zipfPage(generator) : (int)(offset - SCAN_HOT_LENGTH);
+        }
+        case PATTERN_LOOP: {
+            // Laco sobre todas as paginas, maior que o working set
+            int page = generator->position;
+            generator->position = (generator->position + 1) % generator->pages;
+            return page;
+        }
+        case PATTERN_PHASE: {
+            // A cada fase o processo passa a usar outra janela de paginas
+            int window = generator->pages / PHASE_FRACTION > 0 ? generator->pages / PHASE_FRACTION : 1;
+            if(reference % PHASE_LENGTH == 0) generator->phaseStart = randomBelow(generator, generator->pages);
+            return (generator->phaseStart + randomBelow(generator, window)) % generator->pages;
+        }
+        default:
+            return randomBelow(generator, generator->pages);
+    }
+}
+
+/**
+ * @brief Sorteia se a referencia e uma escrita. Sem escritas o fluxo de paginas nao e alterado
+ *
+ * @param generator Gerador do processo
+ * @return int 1 se escrita
+ */
+int nextGeneratedWrite(Generator *generator){
+    return WRITE_RATIO && randomBelow(generator, 100) < WRITE_RATIO;
+}
+
+/**
+ * @brief Deslocamento da referencia dentro da pagina, sorteado do fluxo so com o modelo de cache ativado
+ *
+ * @param generator Gerador do processo
+ * @return int Deslocamento em bytes
+ */
+int nextGeneratedOffset(Generator *generator){
+    return CACHE_SIZE ? randomBelow(generator, VIRTUAL_PAGE_SIZE) : 0;
+}
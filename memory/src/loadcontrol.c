@@ -0,0 +1,88 @@
+#include "../headers/loadcontrol.h"
+
+int updateFaultRate(Process *process, int fault);
+Process* chooseFrameDonor(Process **processes, int count, Process *faulting);
+Process* chooseSuspendVictim(Process **processes, int count, Process *faulting);
+Process* chooseResumeCandidate(Process **processes, int count, int freeFrames);
+int residentPages(Process *process);
+
+/**
+ * @brief Conta a referencia na janela de medicao do processo. Ao fim da janela calcula a taxa de faltas
+ * e decide o ajuste do conjunto residente: cresce acima de PFF_UPPER e encolhe abaixo de PFF_LOWER
+ *
+ * @param process Processo
+ * @param fault Se a referencia foi uma falta de pagina
+ * @return int RESIDENT_KEEP, RESIDENT_GROW ou RESIDENT_SHRINK
+ */
+int updateFaultRate(Process *process, int fault){
+    process->windowReferences++;
+    process->windowFaults += fault;
+    if(process->windowReferences < PFF_INTERVAL) return RESIDENT_KEEP;
+
+    process->faultRate = (double)process->windowFaults / process->windowReferences;
+    process->windowReferences = 0;
+    process->windowFaults = 0;
+
+    if(process->faultRate * 100 > PFF_UPPER && process->workingSet->limit < WORKING_SET_LIMIT) return RESIDENT_GROW;
+    if(process->faultRate * 100 < PFF_LOWER && process->workingSet->limit > 1) return RESIDENT_SHRINK;
+    return RESIDENT_KEEP;
+}
+
+int residentPages(Process *process){
+    return process->workingSet->limit - process->workingSet->remainingSlots;
+}
+
+/**
+ * @brief Processo que pode ceder um frame: a menor taxa de faltas abaixo de PFF_LOWER, com mais de uma pagina residente
+ *
+ * @return Process* Processo ou NULL se nenhum
+ */
+Process* chooseFrameDonor(Process **processes, int count, Process *faulting){
+    Process *donor = NULL;
+    for(int i = 0; i < count; i++){
+        Process *process = processes[i];
+        if(process == faulting || process->status == PROCESS_SUSPENDED || residentPages(process) <= 1) continue;
+        if(process->faultRate * 100 >= PFF_LOWER) continue;
+        if(!donor || process->faultRate < donor->faultRate) donor = process;
+    }
+    return donor;
+}
+
+/**
+ * @brief Processo a ser suspenso com o sistema sobrecarregado: a menor prioridade e, no empate, o maior conjunto residente
+ *
+ * @return Process* Processo ou NULL se so o processo com a falta tem paginas na memoria
+ */
+Process* chooseSuspendVictim(Process **processes, int count, Process *faulting){
+    Process *victim = NULL;
+    for(int i = 0; i < count; i++){
+        Process *process = processes[i];
+        if(process == faulting || process->status == PROCESS_SUSPENDED || residentPages(process) == 0) continue;
+        if(!victim || process->priority < victim->priority || (process->priority == victim->priority && residentPages(process) > residentPages(victim))){
+            victim = process;
+        }
+    }
+    return victim;
+}
+
+/**
+ * @brief Processo suspenso a ser retomado: a maior prioridade entre os que cabem nos frames livres.
+ * Se nenhum processo esta pronto, retoma o de maior prioridade mesmo sem frames suficientes
+ *
+ * @return Process* Processo ou NULL se nenhum
+ */
+Process* chooseResumeCandidate(Process **processes, int count, int freeFrames){
+    Process *candidate = NULL;
+    Process *fitting = NULL;
+    int anyReady = 0;
+    for(int i = 0; i < count; i++){
+        Process *process = processes[i];
+        if(process->status != PROCESS_SUSPENDED){
+            anyReady = 1;
+            continue;
+        }
+        if(!candidate || process->priority > candidate->priority) candidate = process;
+        if(process->workingSet->limit <= freeFrames && (!fitting || process->priority > fitting->priority)) fitting = process;
+    }
+    return anyReady ? fitting : candidate;
+}
@@ -1,58 +1,349 @@
 #include "../headers/globals.h"
 #include "../headers/memory_arguments.h"
 #include "../headers/structures.h"
+#include "../headers/replacement.h"
+#include "../headers/trace.h"
+#include "../headers/mrc.h"
+#include "../headers/loadcontrol.h"
+#include "../headers/tlb.h"
+#include "../headers/parallel.h"
+#include "../headers/swap.h"
+#include "../headers/zswap.h"
+#include "../headers/sharing.h"
+#include "../headers/numa.h"
+#include "../headers/cache.h"
 
-int requestPage();
+void simulateRandom();
+void simulateTrace();
+void simulateThreads();
+void accessPage(Process *process, int pageNumber, int write, int offset);
+int resolveReference(Process *process, int pageNumber, int write);
+int accessSharedPage(Process *process, int pageNumber);
+void copyOnWrite(Process *process, int pageNumber);
+void translateAddress(Process *process, int pageNumber);
+void releaseExpiredPages(Process *process);
+void checkStoppingLimit(int count);
+void endCycle();
 void pageFault(Process *process, int pageNumber);
+void reserveFrame(Process *process);
+int allocatePageFrame(Process *process, int pageNumber);
+void adjustResidentSet(Process *process, int adjustment);
+void releaseFrame(Process *process);
+void suspendProcess(Process *process);
+void resumeProcess(Process *process);
+void resumeProcesses();
+void printFaultRates();
 int getOldestProcess();
+void printStatistics(char *title);
+double elapsedSeconds();
 
 int activeProcesses = 0;
 int lastProcessRemoved = 0;
 
 Process* processes[MAX_PROCESSES];
 RAM *ram;
+Statistics statistics;
+struct timespec startTime;
 
 int main(int argc, char *argv[]){
-    srand(time(NULL));
-
     readArgumentsFromConsole(argc, argv);
+    srand(generatorSeed());
 
     ram = createRam();
+    if(TLB_ENTRIES) createTLB();
+    if(SWAP_READ_LATENCY) createSwapDevice();
+    if(ZSWAP_PERCENT) createZswapPool(ram);
+    if(SHARED_PAGES) createSharedLibrary();
+    if(NUMA_NODES) createNuma();
+    if(CACHE_SIZE) createCaches();
+    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    if(TRACE_FILE){
+        openTrace(TRACE_FILE);
+        if(REPLACEMENT_POLICY == POLICY_OPT) indexTraceNextUses();
+        simulateTrace();
+    }else if(THREADS){
+        simulateThreads();
+    }else{
+        simulateRandom();
+    }
+    return 0;
+}
+
+/**
+ * @brief Simula os processos com paginas aleatorias, um acesso por processo ativo a cada ciclo
+ */
+void simulateRandom(){
     int count = 0;
     while(1){
-        if(STOPPING_LIMIT != -1 && count++ >= STOPPING_LIMIT) exitProgram(COUNTER_END, "Contador chegou ao final");
+        checkStoppingLimit(count++);
+        if(PFF_INTERVAL) resumeProcesses();
         for(int i = 0; i < activeProcesses; i++){
-            int requestedPage = requestPage();
-            printf("? Processo %d solicitando pagina %d\n", i, requestedPage);
+            if(processes[i]->status == PROCESS_SUSPENDED) continue;
+            int requestedPage = nextReferencedPage(processes[i]);
+            int write = nextGeneratedWrite(processes[i]->generator);
+            int offset = nextGeneratedOffset(processes[i]->generator);
+            if(!BATCH_INTERVAL) printf("? Processo %d %s pagina %d\n", i, write ? "escrevendo na" : "solicitando", requestedPage);
 
-            int address = readPageFromWorkingSet(processes[i], requestedPage);
+            if(write) statistics.writes++;
+            accessPage(processes[i], requestedPage, write, offset);
+        }
+        if(activeProcesses < PROCESSES) {
+            // Com fork, o novo processo herda a tabela de paginas de um processo ativo
+            Process *parent = FORK_RATIO && activeProcesses && rand() % 100 < FORK_RATIO ? processes[rand() % activeProcesses] : NULL;
+            processes[activeProcesses] = parent ? forkProcess(parent, activeProcesses, ram) : createProcess(activeProcesses);
 
-            if(address != -1){
-                printf("$ Pagina encontrada no endereco %d\n",address);
-            }else{
-                pageFault(processes[i], requestedPage);
+            int requestedPage = nextReferencedPage(processes[activeProcesses]);
+            int write = nextGeneratedWrite(processes[activeProcesses]->generator);
+            int offset = nextGeneratedOffset(processes[activeProcesses]->generator);
+            if(!BATCH_INTERVAL){
+                if(parent) printf("+ Processo %d foi criado por fork do processo %d e esta %s pagina %d\n", activeProcesses, parent->pid, write ? "escrevendo na" : "solicitando", requestedPage);
+                else printf("+ Processo %d foi criado e esta %s pagina %d\n", activeProcesses, write ? "escrevendo na" : "solicitando", requestedPage);
             }
-            printTLB(processes[i]);
+
+            if(write) statistics.writes++;
+            accessPage(processes[activeProcesses], requestedPage, write, offset);
+            activeProcesses++;
         }
-        if(activeProcesses < PROCESSES) {
+        endCycle();
+    }
+}
+
+/**
+ * @brief Cria todos os processos de uma vez e divide as referencias entre as threads
+ */
+void simulateThreads(){
+    for(; activeProcesses < PROCESSES; activeProcesses++) processes[activeProcesses] = createProcess(activeProcesses);
+    simulateParallel(processes);
+    exitProgram(COUNTER_END, "Contador chegou ao final");
+}
+
+/**
+ * @brief Simula as referencias do trace na ordem do arquivo, uma referencia por ciclo.
+ * Os processos sao criados na primeira referencia de cada pid
+ */
+void simulateTrace(){
+    TraceReference reference;
+    int count = 0;
+    while(nextTraceReference(&reference)){
+        checkStoppingLimit(count++);
+        while(activeProcesses <= reference.process){
             processes[activeProcesses] = createProcess(activeProcesses);
+            if(!BATCH_INTERVAL) printf("+ Processo %d foi criado\n", activeProcesses);
+            activeProcesses++;
+        }
 
-            int requestedPage = requestPage();
-            printf("+ Processo %d foi criado e esta solicitando pagina %d\n", activeProcesses, requestedPage);
+        Process *process = processes[reference.process];
+        // O trace nao pode ser adiado, entao a referencia de um processo suspenso o retoma
+        if(process->status == PROCESS_SUSPENDED) resumeProcess(process);
+        int requestedPage = replacementPolicy()->nextReference ? nextReferencedPage(process) : translatePage(process, reference.page);
+        if(!BATCH_INTERVAL) printf("? Processo %d %s pagina virtual %llx\n", process->pid, reference.write ? "escrevendo na" : "lendo a", reference.page);
 
-            pageFault(processes[activeProcesses], requestedPage);
+        if(reference.write) statistics.writes++;
+        accessPage(process, requestedPage, reference.write, reference.offset);
+        endCycle();
+    }
 
-            printTLB(processes[activeProcesses]);
+    printStatistics("Estatisticas finais");
+    if(MRC_MODE) printMissRatioCurves();
+    printf("Fim do trace\n");
+}
 
-            activeProcesses++;
+/**
+ * @brief Acessa a pagina do processo, tratando a falta de pagina
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @param write Se a referencia e uma escrita
+ * @param offset Deslocamento dentro da pagina, usado pelo modelo de cache
+ */
+void accessPage(Process *process, int pageNumber, int write, int offset){
+    translateAddress(process, pageNumber);
+    statistics.references++;
+    if(MRC_MODE) recordMrcReference(process->pid, pageNumber);
+
+    // A biblioteca e somente leitura
+    if(isSharedPage(pageNumber)) write = 0;
+    int fault = resolveReference(process, pageNumber, write);
+    if(SWAP_READ_LATENCY) recordSwapReference(process, pageNumber, write, fault);
+    if(NUMA_NODES) recordNumaAccess(ram, process, pageNumber);
+    if(CACHE_SIZE) recordCacheAccess(process, pageNumber, offset);
+    releaseExpiredPages(process);
+    if(PFF_INTERVAL) adjustResidentSet(process, updateFaultRate(process, fault));
+    if(!BATCH_INTERVAL) printTLB(process);
+}
+
+/**
+ * @brief Encontra a pagina na memoria ou trata a falta. A escrita em um frame herdado pelo fork e copiada
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @param write Se a referencia e uma escrita
+ * @return int 1 se houve falta de pagina
+ */
+int resolveReference(Process *process, int pageNumber, int write){
+    if(isSharedPage(pageNumber)) return accessSharedPage(process, pageNumber);
+
+    int address = readPageFromWorkingSet(process, pageNumber);
+    if(address == -1){
+        pageFault(process, pageNumber);
+        return 1;
+    }
+
+    statistics.hits++;
+    if(!BATCH_INTERVAL) printf("$ Pagina encontrada no endereco %d\n",address);
+    if(write && frameMappings(ram, address) > 1) copyOnWrite(process, pageNumber);
+    return 0;
+}
+
+/**
+ * @brief Acessa uma pagina da biblioteca compartilhada. Na falta, a pagina e lida para o page cache se
+ * ninguem a tiver e depois mapeada no processo, sem ocupar o working set
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina da biblioteca
+ * @return int 1 se houve falta de pagina
+ */
+int accessSharedPage(Process *process, int pageNumber){
+    int address = lookupPageTable(process->workingSet->pageTable, virtualPageOf(process, pageNumber));
+    int cached = sharedPageFrame(pageNumber) != -1;
+
+    if(address == -1){
+        statistics.pageFaults++;
+        if(!cached){
+            reserveFrame(process);
+            insertSharedPage(pageNumber, allocatePageFrame(process, pageNumber));
         }
+        mapSharedPage(process, pageNumber, ram);
+        if(!BATCH_INTERVAL) printf("> Pagina %d da biblioteca %s no endereco %d\n", pageNumber, cached ? "mapeada do page cache" : "lida", sharedPageFrame(pageNumber));
+    }else{
+        statistics.hits++;
+        if(!BATCH_INTERVAL) printf("$ Pagina da biblioteca encontrada no endereco %d\n", address);
+    }
+    touchSharedPage(pageNumber, address == -1, cached);
+    return address == -1;
+}
+
+/**
+ * @brief Escrita em pagina cujo frame ainda e compartilhado com o pai ou os filhos: o processo passa a ter
+ * uma copia propria. Liberar espaco para a copia pode ter desfeito o compartilhamento ou retirado a pagina
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ */
+void copyOnWrite(Process *process, int pageNumber){
+    reserveFrame(process);
+
+    long long virtualPage = virtualPageOf(process, pageNumber);
+    int shared = lookupPageTable(process->workingSet->pageTable, virtualPage);
+    if(shared == -1){
+        pageFault(process, pageNumber);
+        return;
+    }
+    if(frameMappings(ram, shared) == 1){
+        recordCopyOnWrite(0);
+        return;
+    }
+
+    int address = allocatePageFrame(process, pageNumber);
+    mapPage(process->workingSet->pageTable, virtualPage, address);
+    removePageFromRAM(ram, shared);
+    invalidateTLBEntry(process->pid, pageNumber);
+    recordCopyOnWrite(1);
+    if(!BATCH_INTERVAL) printf("C Pagina %d copiada na escrita do frame %d para o frame %d\n", pageNumber, shared, address);
+}
+
+/**
+ * @brief Traduz a pagina pelo modelo de TLB, quando ativado
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ */
+void translateAddress(Process *process, int pageNumber){
+    if(!TLB_ENTRIES) return;
+
+    int level = accessTLB(process->pid, pageNumber);
+    if(!BATCH_INTERVAL) printf("T Traducao da pagina %d %s\n", pageNumber, level == TLB_L1_HIT ? "encontrada na TLB L1" : level == TLB_L2_HIT ? "encontrada na TLB L2" : "fez page walk");
+}
+
+/**
+ * @brief Libera os frames das paginas que sairam da janela do working set do processo
+ * 
+ * @param process Processo
+ */
+void releaseExpiredPages(Process *process){
+    PageValues pv;
+    while((pv = removeExpiredPage(process)).page != -1){
+        removePageFromRAM(ram, pv.address);
+        statistics.expiredPages++;
+        if(!BATCH_INTERVAL) printf("- Pagina %d saiu do working set do processo %d, frame %d liberado\n", pv.page, process->pid, pv.address);
+    }
+    if(!BATCH_INTERVAL && REPLACEMENT_POLICY == POLICY_WORKING_SET) printf("~ Working set do processo %d: %d paginas\n", process->pid, workingSetSize(process));
+}
+
+/**
+ * @brief Encerra a simulacao ao atingir a quantidade maxima de ciclos
+ * 
+ * @param count Ciclos ja executados
+ */
+void checkStoppingLimit(int count){
+    if(STOPPING_LIMIT != -1 && count >= STOPPING_LIMIT){
+        if(BATCH_INTERVAL) printStatistics("Estatisticas finais");
+        if(MRC_MODE) printMissRatioCurves();
+        exitProgram(COUNTER_END, "Contador chegou ao final");
+    }
+}
+
+/**
+ * @brief Fim do ciclo: no modo em lote roda sem espera e o progresso e impresso periodicamente
+ */
+void endCycle(){
+    statistics.cycles++;
+    if(BATCH_INTERVAL){
+        if(statistics.cycles % BATCH_INTERVAL == 0) printStatistics("Progresso");
+    }else{
         sleep(WAIT_TIME);
     }
-    return 0;
 }
 
-int requestPage(){
-    return rand() % NUM_PAGES;
+/**
+ * @brief Tempo decorrido desde o inicio da simulacao
+ * 
+ * @return double Tempo em segundos
+ */
+double elapsedSeconds(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - startTime.tv_sec) + (now.tv_nsec - startTime.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Imprime os contadores agregados da simulacao
+ * 
+ * @param title Titulo do bloco de estatisticas
+ */
+void printStatistics(char *title){
+    double seconds = elapsedSeconds();
+    double references = statistics.references ? (double)statistics.references : 1;
+
+    printf("=== %s: ciclo %lld (%.2fs, politica %s) ===\n", title, statistics.cycles, seconds, replacementPolicy()->name);
+    printf("-> Referencias: %lld (%.0f ref/s)\n", statistics.references, seconds > 0 ? statistics.references / seconds : 0);
+    printf("-> Acertos: %lld (%.2f%%), faltas de pagina: %lld (%.2f%%, %.0f faltas/s)\n", statistics.hits, 100.0 * statistics.hits / references, statistics.pageFaults, 100.0 * statistics.pageFaults / references, seconds > 0 ? statistics.pageFaults / seconds : 0);
+    printf("-> Trocas no working set: %lld, processos retirados da memoria: %lld\n", statistics.replacements, statistics.processRemovals);
+    if(REPLACEMENT_POLICY == POLICY_WORKING_SET){
+        int totalSize = 0;
+        for(int i = 0; i < activeProcesses; i++) totalSize += workingSetSize(processes[i]);
+        printf("-> Working set (janela %d): %d paginas, media de %.1f por processo, %lld paginas liberadas pela janela\n", WORKING_SET_WINDOW, totalSize, activeProcesses ? (double)totalSize / activeProcesses : 0, statistics.expiredPages);
+    }
+    if(PFF_INTERVAL) printFaultRates();
+    if(TLB_ENTRIES) printTLBStatistics();
+    if(SWAP_READ_LATENCY) printSwapStatistics();
+    if(SHARED_PAGES || FORK_RATIO) printSharingStatistics(ram);
+    if(NUMA_NODES) printNumaStatistics(ram, processes, activeProcesses);
+    if(CACHE_SIZE) printCacheStatistics();
+    if(TRACE_FILE) printf("-> Leituras: %lld, escritas: %lld, processos no trace: %d\n", statistics.references - statistics.writes, statistics.writes, activeProcesses);
+    printPageTableStatistics();
+    printf("-> Frames livres: %d de %d\n", ram->remainingSlots, FRAMES);
+    fflush(stdout);
 }
 
 /**
@@ -62,27 +353,167 @@ int requestPage(){
  * @param pageNumber Numero da pagina requisitada
  */
 void pageFault(Process *process, int pageNumber){
+    statistics.pageFaults++;
     if(process->workingSet->remainingSlots == 0){
-        PageValues pv = removeLeastUsedPage(process);
+        statistics.replacements++;
+        PageValues pv = removeVictimPage(process, pageNumber);
         removePageFromRAM(ram, pv.address);
 
-        int address = addPageToRAM(ram);
+        // O frame da vitima continua ocupado se ainda for compartilhado por outro processo
+        reserveFrame(process);
+        int address = allocatePageFrame(process, pageNumber);
         addPageToWorkingSet(process, pageNumber, address);
 
-        printf("X Pagina %d removida. Pagina %d foi adicionada no endereco %d\n", pv.page, pageNumber, address);
+        if(!BATCH_INTERVAL) printf("X Pagina %d removida. Pagina %d foi adicionada no endereco %d\n", pv.page, pageNumber, address);
     }else{
-        if(isRAMFull(ram)){
-            int oldestPid = getOldestProcess();
-            Process *oldestProcess = processes[oldestPid];
-            while(!isWSEmpty(oldestProcess)){
-                PageValues pv = removeLeastUsedPage(oldestProcess);
-                removePageFromRAM(ram, pv.address);
-            }
-            printf("! Memoria principal cheia, o processo %d foi removido\n", oldestPid);
-        }
-        int address = addPageToRAM(ram);
+        reserveFrame(process);
+        int address = allocatePageFrame(process, pageNumber);
         addPageToWorkingSet(process, pageNumber, address);
-        printf("> Pagina %d adicionada no endereco %d\n", pageNumber, address);
+        if(!BATCH_INTERVAL) printf("> Pagina %d adicionada no endereco %d\n", pageNumber, address);
+    }
+}
+
+/**
+ * @brief Garante um frame livre. As paginas da biblioteca sem uso recente saem antes das paginas dos processos;
+ * liberar paginas compartilhadas pode nao liberar o frame, entao repete ate sobrar um
+ * 
+ * @param process Processo que precisa do frame
+ */
+void reserveFrame(Process *process){
+    while(isRAMFull(ram)){
+        if(SHARED_PAGES && reclaimSharedPage(processes, ram)) continue;
+        releaseFrame(process);
+    }
+}
+
+/**
+ * @brief Aloca o frame de uma pagina do processo, pela politica NUMA e pela cor da pagina quando ativadas
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @return int Endereco do frame
+ */
+int allocatePageFrame(Process *process, int pageNumber){
+    int color = PAGE_COLORING ? pageColor(process, pageNumber) : 0;
+    if(NUMA_NODES) return placePage(ram, process, pageNumber, color);
+    return PAGE_COLORING ? addPageToNode(ram, 0, color) : addPageToRAM(ram);
+}
+
+/**
+ * @brief Libera um frame com a memoria cheia. Com o controle de carga, um processo com poucas faltas cede
+ * uma pagina; se nenhum puder ceder, o sistema esta sobrecarregado e um processo e suspenso. Sem ele,
+ * o processo mais antigo e retirado da memoria
+ * 
+ * @param process Processo que teve a falta de pagina
+ */
+void releaseFrame(Process *process){
+    if(!PFF_INTERVAL){
+        int oldestPid = getOldestProcess();
+        Process *oldestProcess = processes[oldestPid];
+        while(!isWSEmpty(oldestProcess)){
+            PageValues pv = removeVictimPage(oldestProcess, -1);
+            removePageFromRAM(ram, pv.address);
+        }
+        statistics.processRemovals++;
+        if(!BATCH_INTERVAL) printf("! Memoria principal cheia, o processo %d foi removido\n", oldestPid);
+        return;
+    }
+
+    Process *donor = chooseFrameDonor(processes, activeProcesses, process);
+    if(donor){
+        PageValues pv = removeVictimPage(donor, -1);
+        removePageFromRAM(ram, pv.address);
+        resizeResidentSet(donor, -1);
+        statistics.donatedFrames++;
+        if(!BATCH_INTERVAL) printf("< Processo %d (%.1f%% de faltas) cedeu o frame %d da pagina %d\n", donor->pid, 100 * donor->faultRate, pv.address, pv.page);
+        return;
+    }
+
+    Process *victim = chooseSuspendVictim(processes, activeProcesses, process);
+    if(victim){
+        suspendProcess(victim);
+        return;
+    }
+
+    // So o proprio processo esta na memoria: o limite dele nao cabe nos frames e e reduzido, sem ficar abaixo de 1
+    PageValues pv = removeVictimPage(process, -1);
+    removePageFromRAM(ram, pv.address);
+    if(process->workingSet->limit > 1) resizeResidentSet(process, -1);
+    statistics.replacements++;
+    if(!BATCH_INTERVAL) printf("X Pagina %d removida, o limite do processo %d foi reduzido para %d\n", pv.page, process->pid, process->workingSet->limit);
+}
+
+/**
+ * @brief Aplica o ajuste do conjunto residente decidido pela taxa de faltas
+ * 
+ * @param process Processo
+ * @param adjustment RESIDENT_KEEP, RESIDENT_GROW ou RESIDENT_SHRINK
+ */
+void adjustResidentSet(Process *process, int adjustment){
+    if(adjustment == RESIDENT_GROW){
+        resizeResidentSet(process, 1);
+        statistics.residentGrows++;
+    }else if(adjustment == RESIDENT_SHRINK){
+        if(process->workingSet->remainingSlots == 0){
+            PageValues pv = removeVictimPage(process, -1);
+            removePageFromRAM(ram, pv.address);
+        }
+        resizeResidentSet(process, -1);
+        statistics.residentShrinks++;
+    }else{
+        return;
+    }
+    if(!BATCH_INTERVAL) printf("~ Processo %d com %.1f%% de faltas, limite residente %s para %d\n", process->pid, 100 * process->faultRate, adjustment == RESIDENT_GROW ? "aumentado" : "reduzido", process->workingSet->limit);
+}
+
+/**
+ * @brief Suspende o processo, retirando todas as suas paginas da memoria
+ * 
+ * @param process Processo
+ */
+void suspendProcess(Process *process){
+    int pages = 0;
+    while(!isWSEmpty(process)){
+        PageValues pv = removeVictimPage(process, -1);
+        removePageFromRAM(ram, pv.address);
+        pages++;
+    }
+
+    process->status = PROCESS_SUSPENDED;
+    statistics.suspensions++;
+    statistics.swappedPages += pages;
+    if(!BATCH_INTERVAL) printf("! Memoria sobrecarregada, processo %d (prioridade %d, %d paginas) suspenso\n", process->pid, process->priority, pages);
+}
+
+void resumeProcess(Process *process){
+    process->status = PROCESS_READY;
+    process->windowReferences = 0;
+    process->windowFaults = 0;
+    statistics.resumes++;
+    if(!BATCH_INTERVAL) printf("+ Processo %d (prioridade %d) retomado\n", process->pid, process->priority);
+}
+
+/**
+ * @brief Retoma os processos suspensos cujo conjunto residente cabe nos frames livres. Cada processo retomado
+ * reserva o seu limite, mesmo antes de carregar as paginas, para nao sobrecarregar a memoria de novo
+ */
+void resumeProcesses(){
+    Process *process;
+    int available = ram->remainingSlots;
+    while((process = chooseResumeCandidate(processes, activeProcesses, available))){
+        resumeProcess(process);
+        available -= process->workingSet->limit;
+    }
+}
+
+/**
+ * @brief Imprime os eventos do controle de carga e a taxa de faltas de cada processo
+ */
+void printFaultRates(){
+    printf("-> Controle de carga: %lld suspensoes (%lld paginas), %lld retomadas, %lld frames cedidos, limites aumentados %lld e reduzidos %lld vezes\n", statistics.suspensions, statistics.swappedPages, statistics.resumes, statistics.donatedFrames, statistics.residentGrows, statistics.residentShrinks);
+    for(int i = 0; i < activeProcesses; i++){
+        Process *process = processes[i];
+        printf("-> P%-2d prioridade %d: %5.1f%% de faltas, %d de %d paginas residentes%s\n", process->pid, process->priority, 100 * process->faultRate, residentPages(process), process->workingSet->limit, process->status == PROCESS_SUSPENDED ? " (suspenso)" : "");
     }
 }
 
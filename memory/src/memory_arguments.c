@@ -1,4 +1,5 @@
 #include "../headers/memory_arguments.h"
+#include "../headers/cache.h"
 
 int frames;
 int maxProcesses;
@@ -6,6 +7,43 @@ int numPages;
 int workingSetLimit;
 int waitTime;
 int stoppingLimit;
+int batchInterval;
+int replacementPolicyType;
+char *traceFile;
+int virtualPageSize;
+int mrcMode;
+int shardsSize;
+int workingSetWindow;
+int pffInterval;
+int pffUpper;
+int pffLower;
+int tlbEntries;
+int tlbWays;
+int tlbL2Entries;
+int tlbL2Ways;
+int tlbReplacement;
+int tlbAsid;
+int pattern;
+int zipfExponent;
+int seed;
+int threads;
+int swapReadLatency;
+int swapWriteLatency;
+int swapQueueDepth;
+int swapReadahead;
+int writeRatio;
+int zswapPercent;
+int zswapRatio;
+int zswapIncompressible;
+int sharedPages;
+int forkRatio;
+int numaNodes;
+int numaPolicy;
+int numaMigration;
+int numaRemoteLatency;
+int cacheSize;
+int cacheWays;
+int pageColoring;
 
 /*
  * Verifica se o parametro e um numero
@@ -32,6 +70,43 @@ void readArgumentsFromConsole(int argc, char *argv[]){
     workingSetLimit = 4;
     waitTime = 3;
     stoppingLimit = -1;
+    batchInterval = 0;
+    replacementPolicyType = 0;
+    traceFile = NULL;
+    virtualPageSize = 4096;
+    mrcMode = 0;
+    shardsSize = 8192;
+    workingSetWindow = 100;
+    pffInterval = 0;
+    pffUpper = 20;
+    pffLower = 2;
+    tlbEntries = 0;
+    tlbWays = 4;
+    tlbL2Entries = 0;
+    tlbL2Ways = 8;
+    tlbReplacement = 0;
+    tlbAsid = 0;
+    pattern = 0;
+    zipfExponent = 99;
+    seed = 0;
+    threads = 0;
+    swapReadLatency = 0;
+    swapWriteLatency = 100;
+    swapQueueDepth = 32;
+    swapReadahead = 0;
+    writeRatio = 0;
+    zswapPercent = 0;
+    zswapRatio = 30;
+    zswapIncompressible = 10;
+    sharedPages = 0;
+    forkRatio = 0;
+    numaNodes = 0;
+    numaPolicy = 0;
+    numaMigration = 0;
+    numaRemoteLatency = 150;
+    cacheSize = 0;
+    cacheWays = 16;
+    pageColoring = 0;
 
     for(int i = 1; i < argc; i++){
         char *arg = argv[i];
@@ -43,7 +118,7 @@ void readArgumentsFromConsole(int argc, char *argv[]){
         switch(flag){
             case 'f':
                 frames = handleParameter(arg);
-                if(frames > MAX_FRAMES) exitProgram(OVER_MAX, "Mais frames que permitido");
+                if(frames < 1) exitProgram(INVALID_NUMBER, "A memoria deve ter ao menos um frame");
                 break;
             case 'p':
                 maxProcesses = handleParameter(arg);
@@ -51,7 +126,7 @@ void readArgumentsFromConsole(int argc, char *argv[]){
                 break;
             case 'v':
                 numPages = handleParameter(arg);
-                if(numPages > MAX_PAGES) exitProgram(OVER_MAX, "Mais paginas que permitido");
+                if(numPages < 1) exitProgram(INVALID_NUMBER, "O processo deve ter ao menos uma pagina");
                 break;
             case 'w':
                 workingSetLimit = handleParameter(arg);
@@ -62,6 +137,138 @@ void readArgumentsFromConsole(int argc, char *argv[]){
             case 'l':
                 stoppingLimit = handleParameter(arg);
                 break;
+            case 'b':
+                batchInterval = handleParameter(arg);
+                break;
+            case 'r':
+                replacementPolicyType = handleParameter(arg);
+                if(replacementPolicyType > 8) exitProgram(INVALID_ARGUMENT, "Politica de substituicao invalida, use a opcao -h em caso de duvidas");
+                break;
+            case 't':
+                if(arg[0] == '\0') exitProgram(INVALID_ARGUMENT, "Nao foi passado o arquivo de trace");
+                traceFile = arg;
+                break;
+            case 'z':
+                virtualPageSize = handleParameter(arg);
+                if(virtualPageSize < 1) exitProgram(INVALID_NUMBER, "O tamanho da pagina deve ser maior que zero");
+                break;
+            case 'm':
+                mrcMode = handleParameter(arg);
+                if(mrcMode > 2) exitProgram(INVALID_ARGUMENT, "Modo de curva de faltas invalido, use a opcao -h em caso de duvidas");
+                break;
+            case 'k':
+                shardsSize = handleParameter(arg);
+                if(shardsSize < 1) exitProgram(INVALID_NUMBER, "A amostra deve acompanhar ao menos uma pagina");
+                break;
+            case 'd':
+                workingSetWindow = handleParameter(arg);
+                if(workingSetWindow < 1) exitProgram(INVALID_NUMBER, "A janela do working set deve ter ao menos uma referencia");
+                break;
+            case 'c':
+                pffInterval = handleParameter(arg);
+                break;
+            case 'u':
+                pffUpper = handleParameter(arg);
+                if(pffUpper > 100) exitProgram(INVALID_NUMBER, "A taxa de faltas e uma porcentagem");
+                break;
+            case 'n':
+                pffLower = handleParameter(arg);
+                if(pffLower > 100) exitProgram(INVALID_NUMBER, "A taxa de faltas e uma porcentagem");
+                break;
+            case 'e':
+                tlbEntries = handleParameter(arg);
+                break;
+            case 'a':
+                tlbWays = handleParameter(arg);
+                break;
+            case 'j':
+                tlbL2Entries = handleParameter(arg);
+                break;
+            case 'y':
+                tlbL2Ways = handleParameter(arg);
+                break;
+            case 'x':
+                tlbReplacement = handleParameter(arg);
+                if(tlbReplacement > 2) exitProgram(INVALID_ARGUMENT, "Politica de substituicao da TLB invalida, use a opcao -h em caso de duvidas");
+                break;
+            case 'i':
+                tlbAsid = handleParameter(arg);
+                break;
+            case 'g':
+                pattern = handleParameter(arg);
+                if(pattern > 4) exitProgram(INVALID_ARGUMENT, "Padrao de referencias invalido, use a opcao -h em caso de duvidas");
+                break;
+            case 'q':
+                zipfExponent = handleParameter(arg);
+                break;
+            case 'o':
+                seed = handleParameter(arg);
+                break;
+            case 'T':
+                threads = handleParameter(arg);
+                break;
+            case 'S':
+                swapReadLatency = handleParameter(arg);
+                break;
+            case 'W':
+                swapWriteLatency = handleParameter(arg);
+                break;
+            case 'Q':
+                swapQueueDepth = handleParameter(arg);
+                if(swapQueueDepth < 1 || swapQueueDepth > 64) exitProgram(INVALID_NUMBER, "A fila do swap deve ter de 1 a 64 pedidos");
+                break;
+            case 'A':
+                swapReadahead = handleParameter(arg);
+                break;
+            case 'D':
+                writeRatio = handleParameter(arg);
+                if(writeRatio > 100) exitProgram(INVALID_NUMBER, "A taxa de escritas e uma porcentagem");
+                break;
+            case 'Z':
+                zswapPercent = handleParameter(arg);
+                if(zswapPercent > 99) exitProgram(INVALID_NUMBER, "O pool comprimido deve deixar frames para os processos");
+                break;
+            case 'C':
+                zswapRatio = handleParameter(arg);
+                if(zswapRatio < 1) exitProgram(INVALID_NUMBER, "A razao de compressao deve ser maior que zero");
+                break;
+            case 'I':
+                zswapIncompressible = handleParameter(arg);
+                if(zswapIncompressible > 100) exitProgram(INVALID_NUMBER, "A fracao de paginas incompressiveis e uma porcentagem");
+                break;
+            case 'L':
+                sharedPages = handleParameter(arg);
+                break;
+            case 'F':
+                forkRatio = handleParameter(arg);
+                if(forkRatio > 100) exitProgram(INVALID_NUMBER, "A chance de fork e uma porcentagem");
+                break;
+            case 'N':
+                numaNodes = handleParameter(arg);
+                if(numaNodes > MAX_NODES) exitProgram(OVER_MAX, "Mais nos de memoria que permitido");
+                break;
+            case 'P':
+                numaPolicy = handleParameter(arg);
+                if(numaPolicy > 2) exitProgram(INVALID_ARGUMENT, "Politica de alocacao NUMA invalida, use a opcao -h em caso de duvidas");
+                break;
+            case 'M':
+                numaMigration = handleParameter(arg);
+                if(numaMigration > MAX_MIGRATION_STREAK) exitProgram(OVER_MAX, "Mais acessos remotos seguidos que permitido para a migracao");
+                break;
+            case 'R':
+                numaRemoteLatency = handleParameter(arg);
+                break;
+            case 'K':
+                cacheSize = handleParameter(arg);
+                break;
+            case 'U':
+                cacheWays = handleParameter(arg);
+                if(cacheWays < 1) exitProgram(INVALID_NUMBER, "A cache deve ter ao menos uma via");
+                break;
+            case 'O':
+                pageColoring = handleParameter(arg);
+                if(pageColoring > 1) exitProgram(INVALID_ARGUMENT, "Alocacao de frames invalida, use a opcao -h em caso de duvidas");
+                break;
             case 'h':
                 exitProgram(HELP, HELP_TEXT);
                 break;
@@ -69,6 +276,23 @@ void readArgumentsFromConsole(int argc, char *argv[]){
                 exitProgram(INVALID_ARGUMENT, "Nao foi passado um argumento valido, use a opcao -h em caso de duvidas");
         }
     }
+
+    if(pffInterval && pffLower >= pffUpper) exitProgram(INVALID_NUMBER, "O limite inferior da taxa de faltas deve ser menor que o superior");
+    if(tlbEntries && (tlbWays < 1 || tlbEntries % tlbWays)) exitProgram(INVALID_NUMBER, "As entradas da TLB devem ser multiplo da associatividade");
+    if(tlbL2Entries && (!tlbEntries || tlbL2Ways < 1 || tlbL2Entries % tlbL2Ways)) exitProgram(INVALID_NUMBER, "A TLB L2 exige a L1 e entradas multiplo da associatividade");
+    if(pffInterval && replacementPolicyType == 8) exitProgram(INVALID_ARGUMENT, "O controle de carga por taxa de faltas nao se aplica ao working set de Denning");
+    if(threads && stoppingLimit == -1) exitProgram(INVALID_ARGUMENT, "A simulacao com threads exige a quantidade de ciclos (-l)");
+    if(threads && (traceFile || mrcMode || pffInterval || tlbEntries || swapReadLatency)) exitProgram(INVALID_ARGUMENT, "A simulacao com threads nao aceita trace, curvas de faltas, controle de carga, TLB nem swap");
+    if(zswapPercent && !swapReadLatency) exitProgram(INVALID_ARGUMENT, "O pool comprimido exige o dispositivo de swap (-S)");
+    if(sharedPages >= numPages) exitProgram(INVALID_NUMBER, "A biblioteca compartilhada deve deixar paginas privadas ao processo");
+    if((sharedPages || forkRatio) && (traceFile || threads)) exitProgram(INVALID_ARGUMENT, "A biblioteca compartilhada e o fork nao se aplicam ao trace nem a simulacao com threads");
+    if(forkRatio && pffInterval) exitProgram(INVALID_ARGUMENT, "O fork nao se aplica ao controle de carga por taxa de faltas");
+    if(numaNodes > frames) exitProgram(INVALID_NUMBER, "Cada no de memoria deve ter ao menos um frame");
+    if(numaNodes && threads) exitProgram(INVALID_ARGUMENT, "A simulacao com threads nao aceita NUMA");
+    if(cacheSize && !isCacheGeometryValid(cacheSize, cacheWays)) exitProgram(INVALID_NUMBER, "A LLC deve ser maior que a L2 e ter uma potencia de 2 de conjuntos");
+    if(pageColoring && !cacheSize) exitProgram(INVALID_ARGUMENT, "A coloracao de paginas exige o modelo de cache (-K)");
+    if(cacheSize && threads) exitProgram(INVALID_ARGUMENT, "A simulacao com threads nao aceita o modelo de cache");
+    if(threads > maxProcesses) exitProgram(INVALID_NUMBER, "Mais threads que processos");
 }
 
 /**
@@ -97,3 +321,151 @@ int getWaitTime(){
 int getStoppingLimit(){
     return stoppingLimit;
 }
+
+int getBatchInterval(){
+    return batchInterval;
+}
+
+int getReplacementPolicy(){
+    return replacementPolicyType;
+}
+
+char* getTraceFile(){
+    return traceFile;
+}
+
+int getVirtualPageSize(){
+    return virtualPageSize;
+}
+
+int getMrcMode(){
+    return mrcMode;
+}
+
+int getShardsSize(){
+    return shardsSize;
+}
+
+int getWorkingSetWindow(){
+    return workingSetWindow;
+}
+
+int getPffInterval(){
+    return pffInterval;
+}
+
+int getPffUpper(){
+    return pffUpper;
+}
+
+int getPffLower(){
+    return pffLower;
+}
+
+int getTlbEntries(){
+    return tlbEntries;
+}
+
+int getTlbWays(){
+    return tlbWays;
+}
+
+int getTlbL2Entries(){
+    return tlbL2Entries;
+}
+
+int getTlbL2Ways(){
+    return tlbL2Ways;
+}
+
+int getTlbReplacement(){
+    return tlbReplacement;
+}
+
+int getTlbAsid(){
+    return tlbAsid;
+}
+
+int getPattern(){
+    return pattern;
+}
+
+int getZipfExponent(){
+    return zipfExponent;
+}
+
+int getSeed(){
+    return seed;
+}
+
+int getThreads(){
+    return threads;
+}
+
+int getSwapReadLatency(){
+    return swapReadLatency;
+}
+
+int getSwapWriteLatency(){
+    return swapWriteLatency;
+}
+
+int getSwapQueueDepth(){
+    return swapQueueDepth;
+}
+
+int getSwapReadahead(){
+    return swapReadahead;
+}
+
+int getWriteRatio(){
+    return writeRatio;
+}
+
+int getZswapPercent(){
+    return zswapPercent;
+}
+
+int getZswapRatio(){
+    return zswapRatio;
+}
+
+int getZswapIncompressible(){
+    return zswapIncompressible;
+}
+
+int getSharedPages(){
+    return sharedPages;
+}
+
+int getForkRatio(){
+    return forkRatio;
+}
+
+int getNumaNodes(){
+    return numaNodes;
+}
+
+int getNumaPolicy(){
+    return numaPolicy;
+}
+
+int getNumaMigration(){
+    return numaMigration;
+}
+
+int getNumaRemoteLatency(){
+    return numaRemoteLatency;
+}
+
+int getCacheSize(){
+    return cacheSize;
+}
+
+int getCacheWays(){
+    return cacheWays;
+}
+
+int getPageColoring(){
+    return pageColoring;
+}
@@ -0,0 +1,351 @@
+#include "../headers/mrc.h"
+#include <string.h>
+
+StackAnalyzer *globalAnalyzer = NULL;
+StackAnalyzer *processAnalyzers[MAX_PROCESSES];
+unsigned int treapSeed = 2463534242u;
+
+StackAnalyzer* createAnalyzer();
+void growAnalyzer(StackAnalyzer *analyzer);
+int spatialHash(long long key);
+int findNode(StackAnalyzer *analyzer, long long key);
+void insertNode(StackAnalyzer *analyzer, long long key, int node);
+void deleteNode(StackAnalyzer *analyzer, long long key);
+void updateNode(StackAnalyzer *analyzer, int node);
+void splitTreap(StackAnalyzer *analyzer, int node, long long time, int *left, int *right);
+int mergeTreap(StackAnalyzer *analyzer, int left, int right);
+void heapSwap(StackAnalyzer *analyzer, int i, int j);
+void heapPush(StackAnalyzer *analyzer, int node);
+int heapPop(StackAnalyzer *analyzer);
+void evictMaxHash(StackAnalyzer *analyzer);
+void addDistance(StackAnalyzer *analyzer, double distance);
+void analyzeReference(StackAnalyzer *analyzer, long long key);
+void recordMrcReference(int pid, int page);
+void printCurve(char *title, StackAnalyzer *analyzer);
+void printMissRatioCurves();
+
+/**
+ * @brief Cria um analisador de distancias de pilha vazio
+ *
+ * @return StackAnalyzer* Analisador
+ */
+StackAnalyzer* createAnalyzer(){
+    StackAnalyzer *analyzer = (StackAnalyzer *)calloc(1, sizeof(StackAnalyzer));
+    if(!analyzer) exitProgram(OVER_MAX, "Sem memoria para a curva de faltas");
+
+    analyzer->threshold = SHARDS_MODULUS;
+    growAnalyzer(analyzer);
+    return analyzer;
+}
+
+/**
+ * @brief Dobra a quantidade de nos (no SHARDS aloca uma unica vez o tamanho maximo da amostra)
+ */
+void growAnalyzer(StackAnalyzer *analyzer){
+    int oldCapacity = analyzer->capacity;
+    int capacity = MRC_MODE == MRC_SHARDS ? SHARDS_SIZE + 2 : (oldCapacity ? 2 * oldCapacity : 1024);
+
+    analyzer->time = (long long *)realloc(analyzer->time, sizeof(long long) * capacity);
+    analyzer->priority = (unsigned int *)realloc(analyzer->priority, sizeof(unsigned int) * capacity);
+    analyzer->left = (int *)realloc(analyzer->left, sizeof(int) * capacity);
+    analyzer->right = (int *)realloc(analyzer->right, sizeof(int) * capacity);
+    analyzer->size = (int *)realloc(analyzer->size, sizeof(int) * capacity);
+    analyzer->key = (long long *)realloc(analyzer->key, sizeof(long long) * capacity);
+    analyzer->hash = (int *)realloc(analyzer->hash, sizeof(int) * capacity);
+    analyzer->heapIndex = (int *)realloc(analyzer->heapIndex, sizeof(int) * capacity);
+    analyzer->heap = (int *)realloc(analyzer->heap, sizeof(int) * capacity);
+    if(!analyzer->time || !analyzer->priority || !analyzer->left || !analyzer->right || !analyzer->size || !analyzer->key || !analyzer->hash || !analyzer->heapIndex || !analyzer->heap){
+        exitProgram(OVER_MAX, "Sem memoria para a curva de faltas");
+    }
+
+    // O no 0 e o nulo da treap; os novos nos entram na lista de livres
+    analyzer->size[0] = 0;
+    for(int i = capacity - 1; i >= (oldCapacity ? oldCapacity : 1); i--){
+        analyzer->right[i] = analyzer->freeNode;
+        analyzer->freeNode = i;
+    }
+    analyzer->capacity = capacity;
+
+    // Tabela com ocupacao maxima de 50%, reconstruida a cada crescimento
+    int tableCapacity = 1;
+    while(tableCapacity < 2 * capacity) tableCapacity <<= 1;
+    if(tableCapacity == analyzer->tableCapacity) return;
+
+    long long *oldKeys = analyzer->tableKeys;
+    int *oldNodes = analyzer->tableNodes;
+    int oldTableCapacity = analyzer->tableCapacity;
+
+    analyzer->tableKeys = (long long *)malloc(sizeof(long long) * tableCapacity);
+    analyzer->tableNodes = (int *)malloc(sizeof(int) * tableCapacity);
+    if(!analyzer->tableKeys || !analyzer->tableNodes) exitProgram(OVER_MAX, "Sem memoria para a curva de faltas");
+    analyzer->tableCapacity = tableCapacity;
+    for(int i = 0; i < tableCapacity; i++) analyzer->tableKeys[i] = -1;
+
+    for(int i = 0; i < oldTableCapacity; i++){
+        if(oldKeys[i] != -1) insertNode(analyzer, oldKeys[i], oldNodes[i]);
+    }
+    free(oldKeys);
+    free(oldNodes);
+}
+
+/**
+ * @brief Hash espacial da pagina (splitmix64) em [0, SHARDS_MODULUS)
+ */
+int spatialHash(long long key){
+    unsigned long long z = (unsigned long long)key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return z % SHARDS_MODULUS;
+}
+
+/* ===== Tabela pagina -> no (sondagem linear com remocao por deslocamento) ===== */
+
+int findNode(StackAnalyzer *analyzer, long long key){
+    int mask = analyzer->tableCapacity - 1;
+    for(int slot = spatialHash(key) & mask; analyzer->tableKeys[slot] != -1; slot = (slot + 1) & mask){
+        if(analyzer->tableKeys[slot] == key) return analyzer->tableNodes[slot];
+    }
+    return 0;
+}
+
+void insertNode(StackAnalyzer *analyzer, long long key, int node){
+    int mask = analyzer->tableCapacity - 1;
+    int slot = spatialHash(key) & mask;
+    while(analyzer->tableKeys[slot] != -1) slot = (slot + 1) & mask;
+    analyzer->tableKeys[slot] = key;
+    analyzer->tableNodes[slot] = node;
+}
+
+void deleteNode(StackAnalyzer *analyzer, long long key){
+    int mask = analyzer->tableCapacity - 1;
+    int slot = spatialHash(key) & mask;
+    while(analyzer->tableKeys[slot] != key) slot = (slot + 1) & mask;
+
+    // Puxa para tras as chaves seguintes que ficariam inalcancaveis
+    int next = (slot + 1) & mask;
+    while(analyzer->tableKeys[next] != -1){
+        int home = spatialHash(analyzer->tableKeys[next]) & mask;
+        if(((next - home) & mask) >= ((next - slot) & mask)){
+            analyzer->tableKeys[slot] = analyzer->tableKeys[next];
+            analyzer->tableNodes[slot] = analyzer->tableNodes[next];
+            slot = next;
+        }
+        next = (next + 1) & mask;
+    }
+    analyzer->tableKeys[slot] = -1;
+}
+
+/* ===== Treap de estatistica de ordem ===== */
+
+void updateNode(StackAnalyzer *analyzer, int node){
+    analyzer->size[node] = 1 + analyzer->size[analyzer->left[node]] + analyzer->size[analyzer->right[node]];
+}
+
+/**
+ * @brief Separa a treap em nos com ultimo acesso <= time e > time
+ */
+void splitTreap(StackAnalyzer *analyzer, int node, long long time, int *left, int *right){
+    if(!node){
+        *left = *right = 0;
+        return;
+    }
+
+    if(analyzer->time[node] <= time){
+        splitTreap(analyzer, analyzer->right[node], time, &analyzer->right[node], right);
+        *left = node;
+    }else{
+        splitTreap(analyzer, analyzer->left[node], time, left, &analyzer->left[node]);
+        *right = node;
+    }
+    updateNode(analyzer, node);
+}
+
+/**
+ * @brief Junta duas treaps, com todos os nos da esquerda anteriores aos da direita
+ */
+int mergeTreap(StackAnalyzer *analyzer, int left, int right){
+    if(!left) return right;
+    if(!right) return left;
+
+    if(analyzer->priority[left] > analyzer->priority[right]){
+        analyzer->right[left] = mergeTreap(analyzer, analyzer->right[left], right);
+        updateNode(analyzer, left);
+        return left;
+    }
+    analyzer->left[right] = mergeTreap(analyzer, left, analyzer->left[right]);
+    updateNode(analyzer, right);
+    return right;
+}
+
+/* ===== Heap maximo por hash (SHARDS de tamanho fixo) ===== */
+
+void heapSwap(StackAnalyzer *analyzer, int i, int j){
+    int aux = analyzer->heap[i];
+    analyzer->heap[i] = analyzer->heap[j];
+    analyzer->heap[j] = aux;
+    analyzer->heapIndex[analyzer->heap[i]] = i;
+    analyzer->heapIndex[analyzer->heap[j]] = j;
+}
+
+void heapPush(StackAnalyzer *analyzer, int node){
+    int i = analyzer->heapSize++;
+    analyzer->heap[i] = node;
+    analyzer->heapIndex[node] = i;
+    while(i > 0 && analyzer->hash[analyzer->heap[i]] > analyzer->hash[analyzer->heap[(i - 1) / 2]]){
+        heapSwap(analyzer, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+int heapPop(StackAnalyzer *analyzer){
+    int node = analyzer->heap[0];
+    heapSwap(analyzer, 0, --analyzer->heapSize);
+
+    int i = 0;
+    while(1){
+        int largest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+        if(left < analyzer->heapSize && analyzer->hash[analyzer->heap[left]] > analyzer->hash[analyzer->heap[largest]]) largest = left;
+        if(right < analyzer->heapSize && analyzer->hash[analyzer->heap[right]] > analyzer->hash[analyzer->heap[largest]]) largest = right;
+        if(largest == i) break;
+        heapSwap(analyzer, i, largest);
+        i = largest;
+    }
+    return node;
+}
+
+/**
+ * @brief Reduz o limiar de amostragem para o maior hash acompanhado, descartando as paginas com esse hash.
+ * As contagens anteriores sao reescaladas para a nova taxa
+ */
+void evictMaxHash(StackAnalyzer *analyzer){
+    int maxHash = analyzer->hash[analyzer->heap[0]];
+
+    while(analyzer->heapSize && analyzer->hash[analyzer->heap[0]] == maxHash){
+        int node = heapPop(analyzer);
+        int left, middle, right;
+        splitTreap(analyzer, analyzer->root, analyzer->time[node] - 1, &left, &middle);
+        splitTreap(analyzer, middle, analyzer->time[node], &middle, &right);
+        analyzer->root = mergeTreap(analyzer, left, right);
+
+        deleteNode(analyzer, analyzer->key[node]);
+        analyzer->right[node] = analyzer->freeNode;
+        analyzer->freeNode = node;
+        analyzer->numNodes--;
+    }
+
+    double scale = (double)maxHash / analyzer->threshold;
+    for(int i = 0; i < analyzer->histogramSize; i++) analyzer->histogram[i] *= scale;
+    analyzer->coldMisses *= scale;
+    analyzer->references *= scale;
+    analyzer->threshold = maxHash;
+}
+
+void addDistance(StackAnalyzer *analyzer, double distance){
+    int bucket = (int)distance;
+    if(bucket >= analyzer->histogramSize){
+        int size = analyzer->histogramSize ? analyzer->histogramSize : 64;
+        while(size <= bucket) size *= 2;
+
+        analyzer->histogram = (double *)realloc(analyzer->histogram, sizeof(double) * size);
+        if(!analyzer->histogram) exitProgram(OVER_MAX, "Sem memoria para a curva de faltas");
+        memset(analyzer->histogram + analyzer->histogramSize, 0, sizeof(double) * (size - analyzer->histogramSize));
+        analyzer->histogramSize = size;
+    }
+    analyzer->histogram[bucket]++;
+}
+
+/**
+ * @brief Registra a referencia: a distancia de pilha e a quantidade de paginas distintas acessadas
+ * depois do ultimo acesso a mesma pagina, ou seja, os nos com ultimo acesso mais recente
+ */
+void analyzeReference(StackAnalyzer *analyzer, long long key){
+    int hash = spatialHash(key);
+    if(hash >= analyzer->threshold) return;
+
+    analyzer->clock++;
+    analyzer->references++;
+    double rate = (double)analyzer->threshold / SHARDS_MODULUS;
+
+    int node = findNode(analyzer, key);
+    if(node){
+        int left, middle, right;
+        splitTreap(analyzer, analyzer->root, analyzer->time[node] - 1, &left, &middle);
+        splitTreap(analyzer, middle, analyzer->time[node], &middle, &right);
+        addDistance(analyzer, analyzer->size[right] / rate);
+
+        analyzer->time[node] = analyzer->clock;
+        analyzer->root = mergeTreap(analyzer, mergeTreap(analyzer, left, right), node);
+        return;
+    }
+
+    analyzer->coldMisses++;
+    if(!analyzer->freeNode) growAnalyzer(analyzer);
+    node = analyzer->freeNode;
+    analyzer->freeNode = analyzer->right[node];
+    analyzer->numNodes++;
+
+    treapSeed ^= treapSeed << 13;
+    treapSeed ^= treapSeed >> 17;
+    treapSeed ^= treapSeed << 5;
+    analyzer->priority[node] = treapSeed;
+    analyzer->time[node] = analyzer->clock;
+    analyzer->left[node] = analyzer->right[node] = 0;
+    analyzer->size[node] = 1;
+    analyzer->key[node] = key;
+    analyzer->hash[node] = hash;
+    insertNode(analyzer, key, node);
+    analyzer->root = mergeTreap(analyzer, analyzer->root, node);
+
+    if(MRC_MODE == MRC_SHARDS){
+        heapPush(analyzer, node);
+        if(analyzer->numNodes > SHARDS_SIZE) evictMaxHash(analyzer);
+    }
+}
+
+/**
+ * @brief Registra a referencia nas curvas do processo e global
+ *
+ * @param pid Processo
+ * @param page Pagina do processo
+ */
+void recordMrcReference(int pid, int page){
+    if(!globalAnalyzer) globalAnalyzer = createAnalyzer();
+    if(!processAnalyzers[pid]) processAnalyzers[pid] = createAnalyzer();
+
+    analyzeReference(processAnalyzers[pid], page);
+    analyzeReference(globalAnalyzer, (long long)pid << 32 | page);
+}
+
+/**
+ * @brief Imprime a taxa de faltas do LRU para tamanhos de memoria em potencias de 2 ate cobrir todas as distancias
+ */
+void printCurve(char *title, StackAnalyzer *analyzer){
+    printf("=== %s: %.0f referencias, amostragem de %.4f%% ===\n", title, analyzer->references, 100.0 * analyzer->threshold / SHARDS_MODULUS);
+    if(analyzer->references == 0) return;
+
+    int maxDistance = analyzer->histogramSize - 1;
+    while(maxDistance > 0 && analyzer->histogram[maxDistance] == 0) maxDistance--;
+
+    double hits = 0;
+    int bucket = 0;
+    for(long long frames = 1; ; frames *= 2){
+        for(; bucket < frames && bucket < analyzer->histogramSize; bucket++) hits += analyzer->histogram[bucket];
+        printf("-> %lld frames: %.2f%% de faltas\n", frames, 100.0 * (1 - hits / analyzer->references));
+        if(frames > maxDistance) break;
+    }
+}
+
+/**
+ * @brief Imprime as curvas de faltas de cada processo e a global
+ */
+void printMissRatioCurves(){
+    char title[64];
+    for(int i = 0; i < MAX_PROCESSES; i++){
+        if(!processAnalyzers[i]) continue;
+        sprintf(title, "MRC do processo %d", i);
+        printCurve(title, processAnalyzers[i]);
+    }
+    if(globalAnalyzer) printCurve("MRC global", globalAnalyzer);
+}
@@ -0,0 +1,120 @@
+#include "../headers/numa.h"
+#include "../headers/tlb.h"
+
+unsigned char *remoteStreak = NULL;
+NumaStatistics numaStatistics;
+
+void createNuma();
+int homeNode(Process *process);
+int placePage(RAM *ram, Process *process, int pageNumber, int color);
+void recordNumaAccess(RAM *ram, Process *process, int pageNumber);
+void migratePage(RAM *ram, Process *process, int pageNumber, int frame);
+void printNumaStatistics(RAM *ram, Process **processes, int count);
+
+/**
+ * @brief Aloca a sequencia de acessos remotos de cada frame, usada so com a migracao
+ */
+void createNuma(){
+    if(!NUMA_MIGRATION) return;
+    remoteStreak = (unsigned char *)calloc(FRAMES, sizeof(unsigned char));
+    if(remoteStreak == NULL){
+        exit(RAM_CREATION_ERROR);
+    }
+}
+
+/**
+ * @brief No em que o processo executa
+ */
+int homeNode(Process *process){
+    return process->pid % NUMA_NODES;
+}
+
+/**
+ * @brief Aloca o frame da pagina no no escolhido pela politica. Com o no cheio, usa o proximo no com frames
+ * livres, na ordem dos nos a partir do escolhido
+ *
+ * @param ram Memoria principal
+ * @param process Processo que teve a falta
+ * @param pageNumber Pagina do processo
+ * @param color Cor preferida do frame
+ * @return int Endereco do frame alocado ou -1 se a memoria estiver cheia
+ */
+int placePage(RAM *ram, Process *process, int pageNumber, int color){
+    int target = NUMA_POLICY == NUMA_INTERLEAVE ? pageNumber % NUMA_NODES : NUMA_POLICY == NUMA_PREFERRED ? NUMA_PREFERRED_NODE : homeNode(process);
+
+    numaStatistics.allocations++;
+    for(int distance = 0; distance < NUMA_NODES; distance++){
+        int frame = addPageToNode(ram, (target + distance) % NUMA_NODES, color);
+        if(frame == -1) continue;
+
+        if(distance) numaStatistics.fallbacks++;
+        if(remoteStreak) remoteStreak[frame] = 0;
+        return frame;
+    }
+    return -1;
+}
+
+/**
+ * @brief Cobra a latencia do acesso a pagina, ja na memoria, pelo no em que esta o frame. Uma pagina privada
+ * com NUMA_MIGRATION acessos remotos seguidos migra para o no do processo
+ *
+ * @param ram Memoria principal
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ */
+void recordNumaAccess(RAM *ram, Process *process, int pageNumber){
+    int frame = lookupPageTable(process->workingSet->pageTable, virtualPageOf(process, pageNumber));
+    if(frame == -1) return;
+
+    int node = nodeOfFrame(ram, frame);
+    numaStatistics.nodeAccesses[node]++;
+    if(node == homeNode(process)){
+        numaStatistics.localAccesses++;
+        numaStatistics.accessTime += NUMA_LOCAL_LATENCY;
+        if(remoteStreak) remoteStreak[frame] = 0;
+        return;
+    }
+
+    numaStatistics.remoteAccesses++;
+    numaStatistics.accessTime += NUMA_REMOTE_LATENCY;
+    if(NUMA_MIGRATION && ++remoteStreak[frame] >= NUMA_MIGRATION && frameMappings(ram, frame) == 1) migratePage(ram, process, pageNumber, frame);
+}
+
+/**
+ * @brief Copia a pagina para um frame do no do processo. Sem frame livre no no, a pagina fica onde esta e
+ * precisa de outros NUMA_MIGRATION acessos remotos para tentar de novo
+ */
+void migratePage(RAM *ram, Process *process, int pageNumber, int frame){
+    int home = homeNode(process);
+    int target = addPageToNode(ram, home, frame % ram->numColors);
+    remoteStreak[frame] = 0;
+    if(target == -1){
+        numaStatistics.failedMigrations++;
+        return;
+    }
+
+    mapPage(process->workingSet->pageTable, virtualPageOf(process, pageNumber), target);
+    removePageFromRAM(ram, frame);
+    invalidateTLBEntry(process->pid, pageNumber);
+    remoteStreak[target] = 0;
+    numaStatistics.migrations++;
+    numaStatistics.accessTime += NUMA_MIGRATION_TIME;
+    if(!BATCH_INTERVAL) printf("M Pagina %d do processo %d migrada do frame %d (no %d) para o frame %d (no %d)\n", pageNumber, process->pid, frame, nodeOfFrame(ram, frame), target, home);
+}
+
+void printNumaStatistics(RAM *ram, Process **processes, int count){
+    char *policies[] = {"primeiro toque", "intercalada", "preferencial"};
+    long long accesses = numaStatistics.localAccesses + numaStatistics.remoteAccesses;
+    double total = accesses ? (double)accesses : 1;
+
+    printf("-> NUMA: %d nos, alocacao %s, latencia local %d ns e remota %d ns\n", NUMA_NODES, policies[NUMA_POLICY], NUMA_LOCAL_LATENCY, NUMA_REMOTE_LATENCY);
+    printf("-> Acessos: %.2f%% locais, %.2f%% remotos, tempo medio de acesso %.1f ns\n", 100.0 * numaStatistics.localAccesses / total, 100.0 * numaStatistics.remoteAccesses / total, numaStatistics.accessTime / total);
+    printf("-> Alocacoes: %lld, %lld fora do no escolhido; migracoes: %lld (%lld sem frame livre no no do processo)\n", numaStatistics.allocations, numaStatistics.fallbacks, numaStatistics.migrations, numaStatistics.failedMigrations);
+    for(int i = 0; i < NUMA_NODES; i++){
+        MemoryNode *node = &ram->nodes[i];
+        int used = node->frames - node->remainingSlots;
+        int homeProcesses = 0;
+        for(int p = 0; p < count; p++) if(homeNode(processes[p]) == i) homeProcesses++;
+        printf("-> No %d: %d processos, %d de %d frames em uso (%.1f%%), %.2f%% dos acessos\n", i, homeProcesses, used, node->frames, 100.0 * used / node->frames, 100.0 * numaStatistics.nodeAccesses[i] / total);
+    }
+}
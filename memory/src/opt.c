@@ -0,0 +1,188 @@
+#include "../headers/replacement.h"
+#include "../headers/trace.h"
+
+// Proximo uso de uma pagina que nao aparece mais na janela ou no trace (igual a NO_NEXT_USE)
+#define NEVER_USED -1
+
+typedef struct OptState OptState;
+
+/*
+ * OPT (Belady): a vitima e a pagina cujo proximo uso esta mais distante, tirada de um heap maximo.
+ * No trace o proximo uso de cada referencia vem do indice do trace inteiro. Sem trace as referencias do processo
+ * sao geradas com OPT_LOOKAHEAD de antecedencia em um anel, e as ocorrencias de cada pagina no anel
+ * sao encadeadas, entao o proximo uso de cada pagina e conhecido em O(1)
+ */
+struct OptState{
+    Process *process; // dono das referencias
+    int *ring; // paginas das proximas referencias, so sem trace
+    long long *nextSame; // posicao absoluta da proxima ocorrencia da mesma pagina (NEVER_USED se nenhuma)
+    long long *firstUse; // proximo uso de cada pagina
+    long long *lastUse; // ultima ocorrencia de cada pagina no anel
+    long long position; // posicao absoluta da proxima referencia
+
+    int *heap; // paginas do working set por proximo uso
+    int *heapIndex;
+    int size;
+};
+
+void* createOptState(Process *process);
+long long optKey(OptState *opt, int page);
+void optSwap(OptState *opt, int i, int j);
+void optSiftUp(OptState *opt, int i);
+void optSiftDown(OptState *opt, int i);
+void optUpdate(OptState *opt, int page);
+void optAppend(OptState *opt, int page, long long position);
+int optNextReference(void *state);
+void optHit(void *state, int page);
+void optMiss(void *state, int page);
+int optVictim(void *state, int incomingPage);
+
+ReplacementPolicy optPolicy = {"OPT", createOptState, optHit, optMiss, optVictim, optNextReference};
+// Sem trace o gerador nao tem fim, entao o OPT so conhece as proximas OPT_LOOKAHEAD referencias e nao e o otimo de Belady
+ReplacementPolicy windowedOptPolicy = {"OPT em janela", createOptState, optHit, optMiss, optVictim, optNextReference};
+
+void* createOptState(Process *process){
+    OptState *opt = (OptState *)malloc(sizeof(OptState));
+    if(opt == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    opt->firstUse = (long long *)malloc(sizeof(long long) * NUM_PAGES);
+    opt->lastUse = (long long *)malloc(sizeof(long long) * NUM_PAGES);
+    opt->heap = (int *)malloc(sizeof(int) * WORKING_SET_LIMIT);
+    opt->heapIndex = (int *)malloc(sizeof(int) * NUM_PAGES);
+    if(!opt->firstUse || !opt->lastUse || !opt->heap || !opt->heapIndex){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < NUM_PAGES; i++){
+        opt->firstUse[i] = NEVER_USED;
+        opt->lastUse[i] = NEVER_USED;
+        opt->heapIndex[i] = -1;
+    }
+    opt->process = process;
+    opt->size = 0;
+    opt->position = 0;
+    opt->ring = NULL;
+    opt->nextSame = NULL;
+    if(process->pageMap) return opt;
+
+    opt->ring = (int *)malloc(sizeof(int) * OPT_LOOKAHEAD);
+    opt->nextSame = (long long *)malloc(sizeof(long long) * OPT_LOOKAHEAD);
+    if(!opt->ring || !opt->nextSame){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    for(long long i = 0; i < OPT_LOOKAHEAD; i++) optAppend(opt, nextProcessPage(process), i);
+    return opt;
+}
+
+/**
+ * @brief Chave do heap: posicao do proximo uso, com paginas sem uso conhecido no topo
+ */
+long long optKey(OptState *opt, int page){
+    return opt->firstUse[page] == NEVER_USED ? __LONG_LONG_MAX__ : opt->firstUse[page];
+}
+
+void optSwap(OptState *opt, int i, int j){
+    int aux = opt->heap[i];
+    opt->heap[i] = opt->heap[j];
+    opt->heap[j] = aux;
+    opt->heapIndex[opt->heap[i]] = i;
+    opt->heapIndex[opt->heap[j]] = j;
+}
+
+void optSiftUp(OptState *opt, int i){
+    while(i > 0 && optKey(opt, opt->heap[i]) > optKey(opt, opt->heap[(i - 1) / 2])){
+        optSwap(opt, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void optSiftDown(OptState *opt, int i){
+    while(1){
+        int largest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+        if(left < opt->size && optKey(opt, opt->heap[left]) > optKey(opt, opt->heap[largest])) largest = left;
+        if(right < opt->size && optKey(opt, opt->heap[right]) > optKey(opt, opt->heap[largest])) largest = right;
+        if(largest == i) return;
+        optSwap(opt, i, largest);
+        i = largest;
+    }
+}
+
+/**
+ * @brief Reposiciona a pagina no heap apos a mudanca do seu proximo uso
+ */
+void optUpdate(OptState *opt, int page){
+    int index = opt->heapIndex[page];
+    if(index == -1) return;
+    optSiftUp(opt, index);
+    optSiftDown(opt, opt->heapIndex[page]);
+}
+
+/**
+ * @brief Coloca a referencia na posicao absoluta do anel, encadeando-a as ocorrencias anteriores da pagina
+ */
+void optAppend(OptState *opt, int page, long long position){
+    int slot = position % OPT_LOOKAHEAD;
+    opt->ring[slot] = page;
+    opt->nextSame[slot] = NEVER_USED;
+    if(page == -1) return;
+
+    if(opt->lastUse[page] == NEVER_USED){
+        opt->firstUse[page] = position;
+        optUpdate(opt, page);
+    }else{
+        opt->nextSame[opt->lastUse[page] % OPT_LOOKAHEAD] = position;
+    }
+    opt->lastUse[page] = position;
+}
+
+/**
+ * @brief Consome a proxima referencia: no trace atualiza o proximo uso da pagina pelo indice,
+ * sem trace consome a referencia do anel e gera uma nova no fim da janela
+ *
+ * @return int Pagina referenciada
+ */
+int optNextReference(void *state){
+    OptState *opt = (OptState *)state;
+    if(opt->process->pageMap){
+        int page = nextProcessPage(opt->process);
+        opt->firstUse[page] = nextTraceUse();
+        optUpdate(opt, page);
+        return page;
+    }
+
+    int slot = opt->position % OPT_LOOKAHEAD;
+    int page = opt->ring[slot];
+
+    if(page != -1){
+        opt->firstUse[page] = opt->nextSame[slot];
+        if(opt->firstUse[page] == NEVER_USED) opt->lastUse[page] = NEVER_USED;
+        optUpdate(opt, page);
+    }
+
+    optAppend(opt, nextProcessPage(opt->process), opt->position + OPT_LOOKAHEAD);
+    opt->position++;
+    return page;
+}
+
+void optHit(void *state, int page){
+}
+
+void optMiss(void *state, int page){
+    OptState *opt = (OptState *)state;
+    opt->heap[opt->size] = page;
+    opt->heapIndex[page] = opt->size++;
+    optSiftUp(opt, opt->size - 1);
+}
+
+int optVictim(void *state, int incomingPage){
+    OptState *opt = (OptState *)state;
+    int page = opt->heap[0];
+
+    optSwap(opt, 0, --opt->size);
+    opt->heapIndex[page] = -1;
+    optSiftDown(opt, 0);
+    return page;
+}
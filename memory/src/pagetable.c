@@ -0,0 +1,245 @@
+#include "../headers/pagetable.h"
+
+int pageTableLevels = 0;
+
+// Contabilidade das tabelas por nivel (0 e a raiz), de cada thread
+__thread long long liveTables[MAX_PAGE_TABLE_LEVELS];
+__thread long long peakTables[MAX_PAGE_TABLE_LEVELS];
+__thread long long pageTableLookups = 0;
+__thread long long pageTableSteps = 0; // niveis percorridos nas consultas
+
+// Contadores somados das threads que ja terminaram
+long long mergedLiveTables[MAX_PAGE_TABLE_LEVELS];
+long long mergedPeakTables[MAX_PAGE_TABLE_LEVELS];
+long long mergedLookups = 0;
+long long mergedSteps = 0;
+
+int pageTableDepth();
+size_t tableSize(int level);
+void* allocateTable(int level);
+void freeTable(void *table, int level);
+int tableIndex(long long virtualPage, int level);
+PageTable* createPageTable();
+int lookupPageTable(PageTable *table, long long virtualPage);
+void mapPage(PageTable *table, long long virtualPage, int frame);
+void unmapPage(PageTable *table, long long virtualPage);
+void printTable(void *table, int level, long long prefix, int hexadecimal);
+void printPageTable(PageTable *table, int hexadecimal);
+void mergePageTableStatistics();
+void printPageTableStatistics();
+
+/**
+ * @brief Quantidade de niveis para cobrir as paginas de um espaco de VIRTUAL_ADDRESS_BITS bits:
+ * 4 com paginas de 4KB, 3 com paginas de 2MB
+ *
+ * @return int Niveis
+ */
+int pageTableDepth(){
+    if(pageTableLevels) return pageTableLevels;
+
+    int offsetBits = 0;
+    while((2LL << offsetBits) <= VIRTUAL_PAGE_SIZE) offsetBits++;
+
+    int pageBits = VIRTUAL_ADDRESS_BITS - offsetBits;
+    pageTableLevels = pageBits > 0 ? (pageBits + PAGE_TABLE_BITS - 1) / PAGE_TABLE_BITS : 1;
+    if(pageTableLevels > MAX_PAGE_TABLE_LEVELS) pageTableLevels = MAX_PAGE_TABLE_LEVELS;
+    return pageTableLevels;
+}
+
+size_t tableSize(int level){
+    return level == pageTableDepth() - 1 ? sizeof(PageTableLeaf) : sizeof(PageTableNode);
+}
+
+void* allocateTable(int level){
+    void *table;
+    if(level == pageTableDepth() - 1){
+        PageTableLeaf *leaf = (PageTableLeaf *)malloc(sizeof(PageTableLeaf));
+        if(leaf == NULL){
+            exit(PROCESS_CREATION_ERROR);
+        }
+        leaf->used = 0;
+        for(int i = 0; i < PAGE_TABLE_FANOUT; i++) leaf->frames[i] = -1;
+        table = leaf;
+    }else{
+        PageTableNode *node = (PageTableNode *)calloc(1, sizeof(PageTableNode));
+        if(node == NULL){
+            exit(PROCESS_CREATION_ERROR);
+        }
+        table = node;
+    }
+
+    if(++liveTables[level] > peakTables[level]) peakTables[level] = liveTables[level];
+    return table;
+}
+
+void freeTable(void *table, int level){
+    free(table);
+    liveTables[level]--;
+}
+
+/**
+ * @brief Indice da pagina virtual na tabela do nivel
+ */
+int tableIndex(long long virtualPage, int level){
+    return virtualPage >> (PAGE_TABLE_BITS * (pageTableDepth() - 1 - level)) & (PAGE_TABLE_FANOUT - 1);
+}
+
+/**
+ * @brief Cria a tabela de paginas de um processo, so com a raiz alocada
+ *
+ * @return PageTable* Tabela
+ */
+PageTable* createPageTable(){
+    PageTable *table = (PageTable *)malloc(sizeof(PageTable));
+    if(table == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    table->root = allocateTable(0);
+    table->mapped = 0;
+    return table;
+}
+
+/**
+ * @brief Percorre a arvore ate o frame da pagina, parando no primeiro nivel sem tabela
+ *
+ * @param table Tabela de paginas
+ * @param virtualPage Pagina virtual
+ * @return int Frame ou -1 se a pagina nao esta na memoria
+ */
+int lookupPageTable(PageTable *table, long long virtualPage){
+    int levels = pageTableDepth();
+    void *current = table->root;
+    pageTableLookups++;
+
+    for(int level = 0; level < levels - 1; level++){
+        pageTableSteps++;
+        current = ((PageTableNode *)current)->children[tableIndex(virtualPage, level)];
+        if(!current) return -1;
+    }
+    pageTableSteps++;
+    return ((PageTableLeaf *)current)->frames[tableIndex(virtualPage, levels - 1)];
+}
+
+/**
+ * @brief Mapeia a pagina no frame, alocando as tabelas do caminho que ainda nao existem
+ *
+ * @param table Tabela de paginas
+ * @param virtualPage Pagina virtual
+ * @param frame Frame
+ */
+void mapPage(PageTable *table, long long virtualPage, int frame){
+    int levels = pageTableDepth();
+    if(virtualPage >> (PAGE_TABLE_BITS * levels)) exitProgram(OVER_MAX, "Pagina virtual fora do espaco de enderecamento de 48 bits");
+
+    void *current = table->root;
+    for(int level = 0; level < levels - 1; level++){
+        PageTableNode *node = (PageTableNode *)current;
+        int index = tableIndex(virtualPage, level);
+        if(!node->children[index]){
+            node->children[index] = allocateTable(level + 1);
+            node->used++;
+        }
+        current = node->children[index];
+    }
+
+    PageTableLeaf *leaf = (PageTableLeaf *)current;
+    int index = tableIndex(virtualPage, levels - 1);
+    if(leaf->frames[index] == -1){
+        leaf->used++;
+        table->mapped++;
+    }
+    leaf->frames[index] = frame;
+}
+
+/**
+ * @brief Retira a pagina da tabela, liberando as tabelas que ficarem vazias (exceto a raiz)
+ *
+ * @param table Tabela de paginas
+ * @param virtualPage Pagina virtual
+ */
+void unmapPage(PageTable *table, long long virtualPage){
+    int levels = pageTableDepth();
+    PageTableNode *path[MAX_PAGE_TABLE_LEVELS];
+
+    void *current = table->root;
+    for(int level = 0; level < levels - 1; level++){
+        path[level] = (PageTableNode *)current;
+        current = path[level]->children[tableIndex(virtualPage, level)];
+        if(!current) return;
+    }
+
+    PageTableLeaf *leaf = (PageTableLeaf *)current;
+    int index = tableIndex(virtualPage, levels - 1);
+    if(leaf->frames[index] == -1) return;
+    leaf->frames[index] = -1;
+    table->mapped--;
+    if(--leaf->used || levels == 1) return;
+
+    freeTable(leaf, levels - 1);
+    for(int level = levels - 2; level >= 0; level--){
+        path[level]->children[tableIndex(virtualPage, level)] = NULL;
+        if(--path[level]->used || level == 0) return;
+        freeTable(path[level], level);
+    }
+}
+
+void printTable(void *table, int level, long long prefix, int hexadecimal){
+    int levels = pageTableDepth();
+    for(int i = 0; i < PAGE_TABLE_FANOUT; i++){
+        long long page = prefix << PAGE_TABLE_BITS | i;
+        if(level < levels - 1){
+            void *child = ((PageTableNode *)table)->children[i];
+            if(child) printTable(child, level + 1, page, hexadecimal);
+            continue;
+        }
+
+        int frame = ((PageTableLeaf *)table)->frames[i];
+        if(frame == -1) continue;
+        if(hexadecimal) printf("|%llx|%02d|\n", page, frame);
+        else printf("|%02lld|%02d|\n", page, frame);
+        printf("-------\n");
+    }
+}
+
+/**
+ * @brief Imprime as paginas mapeadas em ordem de pagina virtual
+ *
+ * @param table Tabela de paginas
+ * @param hexadecimal Imprime as paginas em hexadecimal (paginas do trace)
+ */
+void printPageTable(PageTable *table, int hexadecimal){
+    printTable(table->root, 0, 0, hexadecimal);
+}
+
+/**
+ * @brief Soma os contadores da thread aos globais e os zera (o pico somado e o das threads, um limite superior)
+ */
+void mergePageTableStatistics(){
+    for(int level = 0; level < MAX_PAGE_TABLE_LEVELS; level++){
+        __atomic_fetch_add(&mergedLiveTables[level], liveTables[level], __ATOMIC_RELAXED);
+        __atomic_fetch_add(&mergedPeakTables[level], peakTables[level], __ATOMIC_RELAXED);
+        liveTables[level] = peakTables[level] = 0;
+    }
+    __atomic_fetch_add(&mergedLookups, pageTableLookups, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&mergedSteps, pageTableSteps, __ATOMIC_RELAXED);
+    pageTableLookups = pageTableSteps = 0;
+}
+
+/**
+ * @brief Imprime as tabelas alocadas por nivel, a memoria usada e a profundidade media das consultas
+ */
+void printPageTableStatistics(){
+    long long bytes = 0;
+    long long peakBytes = 0;
+    long long lookups = pageTableLookups + mergedLookups;
+
+    printf("-> Tabelas de paginas (%d niveis):", pageTableDepth());
+    for(int level = 0; level < pageTableDepth(); level++){
+        long long live = liveTables[level] + mergedLiveTables[level];
+        printf(" L%d %lld", level + 1, live);
+        bytes += live * tableSize(level);
+        peakBytes += (peakTables[level] + mergedPeakTables[level]) * tableSize(level);
+    }
+    printf(", %.1f KB em uso (pico %.1f KB), profundidade media das consultas %.2f\n", bytes / 1024.0, peakBytes / 1024.0, lookups ? (double)(pageTableSteps + mergedSteps) / lookups : 0);
+}
@@ -0,0 +1,277 @@
+#include "../headers/parallel.h"
+#include "../headers/replacement.h"
+#include "../headers/pagetable.h"
+#include <sched.h>
+#include <string.h>
+
+FramePool framePool;
+Worker workers[MAX_THREADS];
+
+void createFramePool();
+int popFrames(unsigned int *frames, int count, WorkerStatistics *statistics);
+void pushFrames(unsigned int *frames, int count);
+void releaseFrameToCache(Worker *worker, unsigned int frame);
+void reclaimFrames(Worker *worker, long long epoch);
+void checkReclaim(Worker *worker);
+unsigned int allocateFrame(Worker *worker);
+void parallelAccess(Worker *worker, Process *process);
+void releaseWorkerPages(Worker *worker);
+void* runWorker(void *arg);
+void simulateParallel(Process **processes);
+void printParallelStatistics(double seconds);
+
+/**
+ * @brief Empilha todos os frames, com o frame 0 no topo
+ */
+void createFramePool(){
+    framePool.next = (unsigned int *)malloc(sizeof(unsigned int) * FRAMES);
+    if(framePool.next == NULL){
+        exit(RAM_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < FRAMES; i++) framePool.next[i] = i + 1 < FRAMES ? (unsigned int)(i + 1) : NO_FRAME;
+    framePool.head = 0;
+    framePool.epoch = 0;
+}
+
+/**
+ * @brief Retira ate count frames da pilha global com um unico CAS. A cadeia lida so e valida se a cabeca,
+ * incluindo a versao, nao mudou ate o CAS
+ *
+ * @return int Frames obtidos
+ */
+int popFrames(unsigned int *frames, int count, WorkerStatistics *statistics){
+    unsigned long long head = __atomic_load_n(&framePool.head, __ATOMIC_ACQUIRE);
+    while(1){
+        unsigned int frame = (unsigned int)head;
+        int taken = 0;
+        while(taken < count && frame != NO_FRAME){
+            frames[taken++] = frame;
+            frame = __atomic_load_n(&framePool.next[frame], __ATOMIC_RELAXED);
+        }
+        if(!taken) return 0;
+
+        unsigned long long newHead = ((head >> 32) + 1) << 32 | frame;
+        if(__atomic_compare_exchange_n(&framePool.head, &head, newHead, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) return taken;
+        statistics->casRetries++;
+    }
+}
+
+/**
+ * @brief Devolve um lote de frames a pilha global, encadeado antes de um unico CAS
+ */
+void pushFrames(unsigned int *frames, int count){
+    if(!count) return;
+
+    for(int i = 0; i < count - 1; i++) __atomic_store_n(&framePool.next[frames[i]], frames[i + 1], __ATOMIC_RELAXED);
+
+    unsigned long long head = __atomic_load_n(&framePool.head, __ATOMIC_ACQUIRE);
+    do{
+        __atomic_store_n(&framePool.next[frames[count - 1]], (unsigned int)head, __ATOMIC_RELAXED);
+    }while(!__atomic_compare_exchange_n(&framePool.head, &head, ((head >> 32) + 1) << 32 | frames[0], 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Guarda o frame liberado no cache da thread, devolvendo um lote a pilha global se o cache estiver cheio
+ */
+void releaseFrameToCache(Worker *worker, unsigned int frame){
+    if(worker->cached == FRAME_CACHE_SIZE){
+        worker->cached -= FRAME_REFILL;
+        pushFrames(worker->cache + worker->cached, FRAME_REFILL);
+    }
+    worker->cache[worker->cached++] = frame;
+}
+
+/**
+ * @brief Parte da thread em uma epoca de recuperacao: devolve o cache e retira paginas dos seus processos em
+ * rodizio, dividindo RECLAIM_BATCH entre as threads. So a thread dona mexe nos working sets, entao nao ha trava
+ *
+ * @param worker Thread
+ * @param epoch Epoca atendida
+ */
+void reclaimFrames(Worker *worker, long long epoch){
+    worker->seenEpoch = epoch;
+    pushFrames(worker->cache, worker->cached);
+    worker->cached = 0;
+
+    unsigned int frames[RECLAIM_BATCH];
+    int share = RECLAIM_BATCH / THREADS > 0 ? RECLAIM_BATCH / THREADS : 1;
+    int taken = 0;
+    int emptyProcesses = 0;
+    while(taken < share && emptyProcesses < worker->numProcesses){
+        Process *process = worker->processes[worker->reclaimCursor];
+        worker->reclaimCursor = (worker->reclaimCursor + 1) % worker->numProcesses;
+        if(isWSEmpty(process)){
+            emptyProcesses++;
+            continue;
+        }
+
+        emptyProcesses = 0;
+        frames[taken++] = removeVictimPage(process, -1).address;
+    }
+    pushFrames(frames, taken);
+    worker->statistics.reclaimedFrames += taken;
+}
+
+/**
+ * @brief Ponto quiescente entre duas referencias: atende a epoca de recuperacao pedida por outra thread
+ */
+void checkReclaim(Worker *worker){
+    long long epoch = __atomic_load_n(&framePool.epoch, __ATOMIC_ACQUIRE);
+    if(epoch != worker->seenEpoch) reclaimFrames(worker, epoch);
+}
+
+/**
+ * @brief Frame livre do cache da thread, recarregado em lote da pilha global. Com a pilha vazia, a thread
+ * abre uma nova epoca de recuperacao e espera as outras devolverem frames nos seus pontos quiescentes
+ *
+ * @param worker Thread
+ * @return unsigned int Frame
+ */
+unsigned int allocateFrame(Worker *worker){
+    int patience = 0;
+    while(1){
+        if(worker->cached) return worker->cache[--worker->cached];
+
+        int taken = popFrames(worker->cache, FRAME_REFILL, &worker->statistics);
+        if(taken){
+            worker->cached = taken;
+            worker->statistics.refills++;
+            continue;
+        }
+
+        long long epoch = __atomic_load_n(&framePool.epoch, __ATOMIC_ACQUIRE);
+        if(epoch == worker->seenEpoch && patience-- <= 0){
+            if(__atomic_compare_exchange_n(&framePool.epoch, &epoch, epoch + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)){
+                worker->statistics.reclaimRequests++;
+                epoch++;
+            }
+            patience = THREADS;
+        }
+        if(epoch != worker->seenEpoch){
+            reclaimFrames(worker, epoch);
+            continue;
+        }
+
+        worker->statistics.waits++;
+        sched_yield();
+    }
+}
+
+/**
+ * @brief Uma referencia do processo: a falta com o working set cheio reaproveita o frame da vitima
+ * sem tocar na pilha global
+ */
+void parallelAccess(Worker *worker, Process *process){
+    checkReclaim(worker);
+
+    int page = nextReferencedPage(process);
+    worker->statistics.references++;
+    if(readPageFromWorkingSet(process, page) != -1){
+        worker->statistics.hits++;
+    }else{
+        worker->statistics.pageFaults++;
+        if(process->workingSet->remainingSlots == 0){
+            worker->statistics.replacements++;
+            PageValues pv = removeVictimPage(process, page);
+            addPageToWorkingSet(process, page, pv.address);
+        }else{
+            addPageToWorkingSet(process, page, allocateFrame(worker));
+        }
+    }
+
+    PageValues pv;
+    while((pv = removeExpiredPage(process)).page != -1) releaseFrameToCache(worker, pv.address);
+}
+
+/**
+ * @brief Devolve todos os frames da thread ao terminar, para as que ainda estao rodando
+ */
+void releaseWorkerPages(Worker *worker){
+    for(int i = 0; i < worker->numProcesses; i++){
+        while(!isWSEmpty(worker->processes[i])) releaseFrameToCache(worker, removeVictimPage(worker->processes[i], -1).address);
+    }
+    pushFrames(worker->cache, worker->cached);
+    worker->cached = 0;
+}
+
+void* runWorker(void *arg){
+    Worker *worker = (Worker *)arg;
+
+    for(int cycle = 0; cycle < STOPPING_LIMIT; cycle++){
+        for(int i = 0; i < worker->numProcesses; i++) parallelAccess(worker, worker->processes[i]);
+    }
+
+    releaseWorkerPages(worker);
+    mergePageTableStatistics();
+    return NULL;
+}
+
+/**
+ * @brief Simula cada grupo de processos em uma thread, com todos disputando os frames da pilha global
+ *
+ * @param processes Processos ja criados
+ */
+void simulateParallel(Process **processes){
+    createFramePool();
+
+    for(int t = 0; t < THREADS; t++){
+        Worker *worker = &workers[t];
+        worker->id = t;
+        worker->processes = (Process **)malloc(sizeof(Process *) * PROCESSES);
+        if(worker->processes == NULL){
+            exit(PROCESS_CREATION_ERROR);
+        }
+        worker->numProcesses = 0;
+        worker->reclaimCursor = 0;
+        worker->cached = 0;
+        worker->seenEpoch = 0;
+        memset(&worker->statistics, 0, sizeof(WorkerStatistics));
+    }
+    for(int i = 0; i < PROCESSES; i++){
+        Worker *worker = &workers[processes[i]->pid % THREADS];
+        worker->processes[worker->numProcesses++] = processes[i];
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(int t = 0; t < THREADS; t++){
+        if(pthread_create(&workers[t].thread, NULL, runWorker, &workers[t])) exitProgram(PROCESS_CREATION_ERROR, "Nao foi possivel criar as threads");
+    }
+    for(int t = 0; t < THREADS; t++) pthread_join(workers[t].thread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printParallelStatistics((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9);
+}
+
+/**
+ * @brief Imprime os contadores somados das threads e a disputa no alocador de frames
+ */
+void printParallelStatistics(double seconds){
+    WorkerStatistics total;
+    memset(&total, 0, sizeof(WorkerStatistics));
+    for(int t = 0; t < THREADS; t++){
+        WorkerStatistics *statistics = &workers[t].statistics;
+        total.references += statistics->references;
+        total.hits += statistics->hits;
+        total.pageFaults += statistics->pageFaults;
+        total.replacements += statistics->replacements;
+        total.refills += statistics->refills;
+        total.casRetries += statistics->casRetries;
+        total.reclaimRequests += statistics->reclaimRequests;
+        total.reclaimedFrames += statistics->reclaimedFrames;
+        total.waits += statistics->waits;
+    }
+    double references = total.references ? (double)total.references : 1;
+
+    printf("=== Estatisticas finais: %d threads, %d ciclos (%.2fs, politica %s) ===\n", THREADS, STOPPING_LIMIT, seconds, replacementPolicy()->name);
+    printf("-> Referencias: %lld (%.0f ref/s)\n", total.references, seconds > 0 ? total.references / seconds : 0);
+    printf("-> Acertos: %lld (%.2f%%), faltas de pagina: %lld (%.2f%%, %.0f faltas/s)\n", total.hits, 100.0 * total.hits / references, total.pageFaults, 100.0 * total.pageFaults / references, seconds > 0 ? total.pageFaults / seconds : 0);
+    printf("-> Trocas no working set: %lld\n", total.replacements);
+    printf("-> Alocador: %lld lotes da pilha global, %lld CAS repetidos, %lld epocas de recuperacao, %lld frames recuperados, %lld esperas\n", total.refills, total.casRetries, total.reclaimRequests, total.reclaimedFrames, total.waits);
+    for(int t = 0; t < THREADS; t++){
+        printf("-> Thread %d: %d processos, %lld referencias (%.0f ref/s)\n", t, workers[t].numProcesses, workers[t].statistics.references, seconds > 0 ? workers[t].statistics.references / seconds : 0);
+    }
+    printPageTableStatistics();
+    fflush(stdout);
+}
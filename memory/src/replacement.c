@@ -0,0 +1,464 @@
+#include "../headers/replacement.h"
+
+typedef struct ListState ListState;
+typedef struct ClockState ClockState;
+typedef struct LfuState LfuState;
+
+// Estado das politicas baseadas em uma unica lista (LRU e FIFO)
+struct ListState{
+    PageList list;
+    PageElement **nodes;
+};
+
+// Relogio circular com um slot por pagina do working set
+struct ClockState{
+    int *slotPage; // pagina de cada slot (-1 se livre)
+    char *referenced;
+    int *slotOf; // slot de cada pagina (-1 se fora do WS)
+    int *freeSlots;
+    int numFree;
+    int capacity; // slots alocados: o maior limite de paginas residentes do processo ate agora
+    int hand;
+};
+
+// Heap minimo por (contador, ultimo uso) das paginas do working set
+struct LfuState{
+    int *heap;
+    int *heapIndex;
+    int *count;
+    long long *lastUse;
+    int size;
+    int capacity; // posicoes do heap: o maior limite de paginas residentes do processo ate agora
+    long long references;
+};
+
+// Elementos livres das listas de paginas, encadeados por next. Os blocos do pool nunca sao devolvidos,
+// entao depois do aquecimento as faltas de pagina nao fazem malloc/free. Cada thread tem o seu pool,
+// ja que os processos do modo paralelo pertencem sempre a mesma thread
+__thread PageElement *freeElements = NULL;
+// Primeiro elemento de cada bloco alocado, para os blocos das threads que ja terminaram continuarem alcancaveis
+PageElement *elementChunks = NULL;
+
+ReplacementPolicy* replacementPolicy();
+int nextReferencedPage(Process *process);
+void initPageList(PageList *list);
+PageElement* pushPage(PageList *list, PageElement **nodes, int page, int tag);
+void unlinkPage(PageList *list, PageElement *element);
+void appendPage(PageList *list, PageElement *element);
+int popPage(PageList *list, PageElement **nodes);
+void dropPage(PageList *list, PageElement **nodes, int page);
+PageElement** createNodeIndex();
+void growElementPool();
+PageElement* allocateElement();
+void releaseElement(PageElement *element);
+void* createListState(Process *process);
+void lruHit(void *state, int page);
+void listMiss(void *state, int page);
+int listVictim(void *state, int incomingPage);
+void fifoHit(void *state, int page);
+void* createClockState(Process *process);
+void clockHit(void *state, int page);
+void clockMiss(void *state, int page);
+int clockVictim(void *state, int incomingPage);
+void clockResize(void *state, int limit);
+void* createLfuState(Process *process);
+int lfuLess(LfuState *lfu, int a, int b);
+void lfuSwap(LfuState *lfu, int i, int j);
+void lfuSiftUp(LfuState *lfu, int i);
+void lfuSiftDown(LfuState *lfu, int i);
+void lfuAge(LfuState *lfu);
+void lfuHit(void *state, int page);
+void lfuMiss(void *state, int page);
+int lfuVictim(void *state, int incomingPage);
+void lfuResize(void *state, int limit);
+
+ReplacementPolicy lruPolicy = {"LRU", createListState, lruHit, listMiss, listVictim, NULL};
+ReplacementPolicy fifoPolicy = {"FIFO", createListState, fifoHit, listMiss, listVictim, NULL};
+ReplacementPolicy clockPolicy = {"Clock", createClockState, clockHit, clockMiss, clockVictim, NULL, NULL, clockResize};
+ReplacementPolicy lfuPolicy = {"LFU", createLfuState, lfuHit, lfuMiss, lfuVictim, NULL, NULL, lfuResize};
+
+/**
+ * @brief Politica de substituicao escolhida na linha de comando
+ *
+ * @return ReplacementPolicy* Politica
+ */
+ReplacementPolicy* replacementPolicy(){
+    static ReplacementPolicy *policies[NUM_POLICIES] = {
+        &lruPolicy, &fifoPolicy, &clockPolicy, &clockProPolicy, &lfuPolicy, &twoQueuePolicy, &arcPolicy, &optPolicy, &workingSetPolicy
+    };
+    if(REPLACEMENT_POLICY == POLICY_OPT && !TRACE_FILE) return &windowedOptPolicy;
+    return policies[REPLACEMENT_POLICY];
+}
+
+/**
+ * @brief Proxima pagina referenciada pelo processo
+ *
+ * @param process Processo
+ * @return int Numero da pagina
+ */
+int nextReferencedPage(Process *process){
+    ReplacementPolicy *policy = replacementPolicy();
+    if(policy->nextReference) return policy->nextReference(process->workingSet->policyState);
+    return nextProcessPage(process);
+}
+
+/* ===== Listas de paginas ===== */
+
+void initPageList(PageList *list){
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+/**
+ * @brief Aloca um bloco de elementos para o pool, dimensionado pelo limite do working set de todos os processos.
+ * As politicas com listas fantasmas (2Q e ARC) guardam ate o dobro do limite
+ */
+void growElementPool(){
+    int size = 2 * WORKING_SET_LIMIT * PROCESSES;
+    if(size < PAGE_POOL_MIN_CHUNK) size = PAGE_POOL_MIN_CHUNK;
+
+    PageElement *chunk = (PageElement *)malloc(sizeof(PageElement) * (size + 1));
+    if(chunk == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    chunk[0].next = __atomic_load_n(&elementChunks, __ATOMIC_RELAXED);
+    while(!__atomic_compare_exchange_n(&elementChunks, &chunk[0].next, chunk, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    for(int i = 1; i <= size; i++){
+        chunk[i].next = freeElements;
+        freeElements = &chunk[i];
+    }
+}
+
+PageElement* allocateElement(){
+#ifdef NO_PAGE_POOL
+    PageElement *element = (PageElement *)malloc(sizeof(PageElement));
+    if(element == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    return element;
+#else
+    if(!freeElements) growElementPool();
+
+    PageElement *element = freeElements;
+    freeElements = element->next;
+    return element;
+#endif
+}
+
+void releaseElement(PageElement *element){
+#ifdef NO_PAGE_POOL
+    free(element);
+#else
+    element->next = freeElements;
+    freeElements = element;
+#endif
+}
+
+/**
+ * @brief Indice pagina -> elemento, com todas as paginas fora das listas
+ *
+ * @return PageElement** Indice
+ */
+PageElement** createNodeIndex(){
+    PageElement **nodes = (PageElement **)calloc(NUM_PAGES, sizeof(PageElement *));
+    if(nodes == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    return nodes;
+}
+
+/**
+ * @brief Adiciona um elemento ja alocado no final da lista
+ */
+void appendPage(PageList *list, PageElement *element){
+    element->next = NULL;
+    element->prev = list->tail;
+    if(list->tail) list->tail->next = element;
+    else list->head = element;
+    list->tail = element;
+    list->size++;
+}
+
+/**
+ * @brief Retira o elemento da lista sem libera-lo
+ */
+void unlinkPage(PageList *list, PageElement *element){
+    if(element->prev) element->prev->next = element->next;
+    else list->head = element->next;
+
+    if(element->next) element->next->prev = element->prev;
+    else list->tail = element->prev;
+    list->size--;
+}
+
+/**
+ * @brief Cria o elemento da pagina no final da lista
+ *
+ * @param list Lista
+ * @param nodes Indice pagina -> elemento
+ * @param page Numero da pagina
+ * @param tag Identificador da lista, para politicas com varias listas
+ * @return PageElement* Elemento criado
+ */
+PageElement* pushPage(PageList *list, PageElement **nodes, int page, int tag){
+    PageElement *element = allocateElement();
+    element->pageNumber = page;
+    element->list = tag;
+    appendPage(list, element);
+    nodes[page] = element;
+    return element;
+}
+
+/**
+ * @brief Remove e libera o elemento mais antigo da lista
+ *
+ * @return int Pagina removida
+ */
+int popPage(PageList *list, PageElement **nodes){
+    PageElement *element = list->head;
+    int page = element->pageNumber;
+
+    unlinkPage(list, element);
+    nodes[page] = NULL;
+    releaseElement(element);
+    return page;
+}
+
+/**
+ * @brief Remove e libera o elemento da pagina
+ */
+void dropPage(PageList *list, PageElement **nodes, int page){
+    PageElement *element = nodes[page];
+
+    unlinkPage(list, element);
+    nodes[page] = NULL;
+    releaseElement(element);
+}
+
+/* ===== LRU e FIFO: a vitima e a cabeca da lista ===== */
+
+void* createListState(Process *process){
+    ListState *state = (ListState *)malloc(sizeof(ListState));
+    if(state == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    initPageList(&state->list);
+    state->nodes = createNodeIndex();
+    return state;
+}
+
+void lruHit(void *state, int page){
+    ListState *lru = (ListState *)state;
+    PageElement *element = lru->nodes[page];
+
+    // Move para o final (mais recentemente usado)
+    if(element == lru->list.tail) return;
+    unlinkPage(&lru->list, element);
+    appendPage(&lru->list, element);
+}
+
+void fifoHit(void *state, int page){
+}
+
+void listMiss(void *state, int page){
+    ListState *list = (ListState *)state;
+    pushPage(&list->list, list->nodes, page, 0);
+}
+
+int listVictim(void *state, int incomingPage){
+    ListState *list = (ListState *)state;
+    return popPage(&list->list, list->nodes);
+}
+
+/* ===== Clock (segunda chance) ===== */
+
+void* createClockState(Process *process){
+    ClockState *clock = (ClockState *)malloc(sizeof(ClockState));
+    if(clock == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    clock->capacity = process->workingSet->limit;
+    clock->slotPage = (int *)malloc(sizeof(int) * clock->capacity);
+    clock->referenced = (char *)calloc(clock->capacity, sizeof(char));
+    clock->freeSlots = (int *)malloc(sizeof(int) * clock->capacity);
+    clock->slotOf = (int *)malloc(sizeof(int) * NUM_PAGES);
+    if(!clock->slotPage || !clock->referenced || !clock->freeSlots || !clock->slotOf){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < clock->capacity; i++){
+        clock->slotPage[i] = -1;
+        clock->freeSlots[i] = clock->capacity - 1 - i;
+    }
+    for(int i = 0; i < NUM_PAGES; i++) clock->slotOf[i] = -1;
+    clock->numFree = clock->capacity;
+    clock->hand = 0;
+    return clock;
+}
+
+void clockHit(void *state, int page){
+    ClockState *clock = (ClockState *)state;
+    clock->referenced[clock->slotOf[page]] = 1;
+}
+
+void clockMiss(void *state, int page){
+    ClockState *clock = (ClockState *)state;
+    int slot = clock->freeSlots[--clock->numFree];
+
+    clock->slotPage[slot] = page;
+    clock->slotOf[page] = slot;
+    clock->referenced[slot] = 1;
+}
+
+int clockVictim(void *state, int incomingPage){
+    ClockState *clock = (ClockState *)state;
+
+    // O ponteiro limpa os bits de referencia ate achar uma pagina sem referencia
+    while(clock->slotPage[clock->hand] == -1 || clock->referenced[clock->hand]){
+        clock->referenced[clock->hand] = 0;
+        clock->hand = (clock->hand + 1) % clock->capacity;
+    }
+
+    int slot = clock->hand;
+    int page = clock->slotPage[slot];
+    clock->slotPage[slot] = -1;
+    clock->slotOf[page] = -1;
+    clock->freeSlots[clock->numFree++] = slot;
+    clock->hand = (clock->hand + 1) % clock->capacity;
+    return page;
+}
+
+/**
+ * @brief Cria os slots que faltam quando o limite do processo passa da capacidade do relogio. Ao encolher,
+ * a vitima ja saiu e seu slot so fica livre
+ */
+void clockResize(void *state, int limit){
+    ClockState *clock = (ClockState *)state;
+    if(limit <= clock->capacity) return;
+
+    clock->slotPage = (int *)realloc(clock->slotPage, sizeof(int) * limit);
+    clock->referenced = (char *)realloc(clock->referenced, sizeof(char) * limit);
+    clock->freeSlots = (int *)realloc(clock->freeSlots, sizeof(int) * limit);
+    if(!clock->slotPage || !clock->referenced || !clock->freeSlots){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int i = clock->capacity; i < limit; i++){
+        clock->slotPage[i] = -1;
+        clock->referenced[i] = 0;
+        clock->freeSlots[clock->numFree++] = i;
+    }
+    clock->capacity = limit;
+}
+
+/* ===== LFU com envelhecimento ===== */
+
+void* createLfuState(Process *process){
+    LfuState *lfu = (LfuState *)malloc(sizeof(LfuState));
+    if(lfu == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    lfu->capacity = process->workingSet->limit;
+    lfu->heap = (int *)malloc(sizeof(int) * lfu->capacity);
+    lfu->heapIndex = (int *)malloc(sizeof(int) * NUM_PAGES);
+    lfu->count = (int *)calloc(NUM_PAGES, sizeof(int));
+    lfu->lastUse = (long long *)calloc(NUM_PAGES, sizeof(long long));
+    if(!lfu->heap || !lfu->heapIndex || !lfu->count || !lfu->lastUse){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    lfu->size = 0;
+    lfu->references = 0;
+    return lfu;
+}
+
+/**
+ * @brief Ordem do heap: menor contador primeiro, empate pelo uso mais antigo
+ */
+int lfuLess(LfuState *lfu, int a, int b){
+    if(lfu->count[a] != lfu->count[b]) return lfu->count[a] < lfu->count[b];
+    return lfu->lastUse[a] < lfu->lastUse[b];
+}
+
+void lfuSwap(LfuState *lfu, int i, int j){
+    int aux = lfu->heap[i];
+    lfu->heap[i] = lfu->heap[j];
+    lfu->heap[j] = aux;
+    lfu->heapIndex[lfu->heap[i]] = i;
+    lfu->heapIndex[lfu->heap[j]] = j;
+}
+
+void lfuSiftUp(LfuState *lfu, int i){
+    while(i > 0 && lfuLess(lfu, lfu->heap[i], lfu->heap[(i - 1) / 2])){
+        lfuSwap(lfu, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void lfuSiftDown(LfuState *lfu, int i){
+    while(1){
+        int smallest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+        if(left < lfu->size && lfuLess(lfu, lfu->heap[left], lfu->heap[smallest])) smallest = left;
+        if(right < lfu->size && lfuLess(lfu, lfu->heap[right], lfu->heap[smallest])) smallest = right;
+        if(smallest == i) return;
+        lfuSwap(lfu, i, smallest);
+        i = smallest;
+    }
+}
+
+/**
+ * @brief Divide os contadores pela metade para esquecer o passado, reconstruindo o heap
+ */
+void lfuAge(LfuState *lfu){
+    for(int i = 0; i < lfu->size; i++) lfu->count[lfu->heap[i]] >>= 1;
+    for(int i = lfu->size / 2 - 1; i >= 0; i--) lfuSiftDown(lfu, i);
+}
+
+void lfuHit(void *state, int page){
+    LfuState *lfu = (LfuState *)state;
+    lfu->count[page]++;
+    lfu->lastUse[page] = ++lfu->references;
+    lfuSiftDown(lfu, lfu->heapIndex[page]);
+
+    if(lfu->references % LFU_AGING_PERIOD == 0) lfuAge(lfu);
+}
+
+void lfuMiss(void *state, int page){
+    LfuState *lfu = (LfuState *)state;
+    lfu->count[page] = 1;
+    lfu->lastUse[page] = ++lfu->references;
+    lfu->heap[lfu->size] = page;
+    lfu->heapIndex[page] = lfu->size++;
+    lfuSiftUp(lfu, lfu->size - 1);
+
+    if(lfu->references % LFU_AGING_PERIOD == 0) lfuAge(lfu);
+}
+
+int lfuVictim(void *state, int incomingPage){
+    LfuState *lfu = (LfuState *)state;
+    int page = lfu->heap[0];
+
+    lfuSwap(lfu, 0, --lfu->size);
+    lfuSiftDown(lfu, 0);
+    return page;
+}
+
+/**
+ * @brief Aumenta o heap quando o limite do processo passa da sua capacidade
+ */
+void lfuResize(void *state, int limit){
+    LfuState *lfu = (LfuState *)state;
+    if(limit <= lfu->capacity) return;
+
+    lfu->heap = (int *)realloc(lfu->heap, sizeof(int) * limit);
+    if(lfu->heap == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    lfu->capacity = limit;
+}
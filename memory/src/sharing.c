@@ -0,0 +1,171 @@
+#include "../headers/sharing.h"
+#include "../headers/tlb.h"
+
+SharedLibrary *sharedLibrary = NULL;
+SharingStatistics sharingStatistics;
+
+void createSharedLibrary();
+int isSharedPage(int pageNumber);
+int sharedPageFrame(int pageNumber);
+void insertSharedPage(int pageNumber, int frame);
+void mapSharedPage(Process *process, int pageNumber, RAM *ram);
+void touchSharedPage(int pageNumber, int fault, int cached);
+int reclaimSharedPage(Process **processes, RAM *ram);
+Process* forkProcess(Process *parent, int pid, RAM *ram);
+void recordCopyOnWrite(int copied);
+void printSharingStatistics(RAM *ram);
+
+void createSharedLibrary(){
+    sharedLibrary = (SharedLibrary *)malloc(sizeof(SharedLibrary));
+    if(sharedLibrary == NULL){
+        exit(RAM_CREATION_ERROR);
+    }
+
+    sharedLibrary->frames = (int *)malloc(sizeof(int) * SHARED_PAGES);
+    sharedLibrary->mappers = (unsigned int *)calloc(SHARED_PAGES, sizeof(unsigned int));
+    sharedLibrary->referenced = (char *)calloc(SHARED_PAGES, sizeof(char));
+    if(!sharedLibrary->frames || !sharedLibrary->mappers || !sharedLibrary->referenced){
+        exit(RAM_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < SHARED_PAGES; i++) sharedLibrary->frames[i] = -1;
+    sharedLibrary->hand = 0;
+    sharedLibrary->resident = 0;
+}
+
+int isSharedPage(int pageNumber){
+    return pageNumber < SHARED_PAGES;
+}
+
+int sharedPageFrame(int pageNumber){
+    return sharedLibrary->frames[pageNumber];
+}
+
+/**
+ * @brief Coloca no page cache a pagina da biblioteca lida para o frame, que fica com a referencia do cache
+ */
+void insertSharedPage(int pageNumber, int frame){
+    sharedLibrary->frames[pageNumber] = frame;
+    sharedLibrary->resident++;
+}
+
+/**
+ * @brief Mapeia a pagina da biblioteca, ja no page cache, na tabela de paginas do processo
+ *
+ * @param process Processo
+ * @param pageNumber Pagina da biblioteca
+ * @param ram Memoria principal
+ */
+void mapSharedPage(Process *process, int pageNumber, RAM *ram){
+    int frame = sharedLibrary->frames[pageNumber];
+    mapPage(process->workingSet->pageTable, virtualPageOf(process, pageNumber), frame);
+    ram->refCount[frame]++;
+    sharedLibrary->mappers[pageNumber] |= 1u << process->pid;
+}
+
+/**
+ * @brief Registra a referencia a pagina da biblioteca
+ *
+ * @param pageNumber Pagina da biblioteca
+ * @param fault Se a pagina nao estava mapeada no processo
+ * @param cached Se a pagina ja estava no page cache
+ */
+void touchSharedPage(int pageNumber, int fault, int cached){
+    sharedLibrary->referenced[pageNumber] = 1;
+    if(!fault) sharingStatistics.libraryHits++;
+    else if(cached) sharingStatistics.libraryMinorFaults++;
+    else sharingStatistics.libraryMajorFaults++;
+}
+
+/**
+ * @brief Avanca o ponteiro da segunda chance pelas paginas da biblioteca no page cache, limpando as referencias,
+ * ate uma pagina sem referencia desde a ultima volta. Ela e retirada de todos os processos pelo mapa reverso
+ * e seu frame e liberado antes de qualquer pagina privada
+ *
+ * @param processes Processos, indexados pelo pid
+ * @param ram Memoria principal
+ * @return int 1 se um frame foi liberado, 0 se nenhuma pagina da biblioteca esta no page cache
+ */
+int reclaimSharedPage(Process **processes, RAM *ram){
+    if(!sharedLibrary->resident) return 0;
+
+    // Na segunda volta todas as referencias ja foram limpas, entao alguma pagina sempre e retirada
+    int page = sharedLibrary->hand;
+    while(sharedLibrary->frames[page] == -1 || sharedLibrary->referenced[page]){
+        sharedLibrary->referenced[page] = 0;
+        page = (page + 1) % SHARED_PAGES;
+    }
+    sharedLibrary->hand = (page + 1) % SHARED_PAGES;
+
+    int frame = sharedLibrary->frames[page];
+    for(unsigned int mappers = sharedLibrary->mappers[page]; mappers; mappers &= mappers - 1){
+        Process *process = processes[__builtin_ctz(mappers)];
+        unmapPage(process->workingSet->pageTable, virtualPageOf(process, page));
+        invalidateTLBEntry(process->pid, page);
+        removePageFromRAM(ram, frame);
+        sharingStatistics.rmapUnmaps++;
+    }
+    removePageFromRAM(ram, frame);
+
+    sharedLibrary->mappers[page] = 0;
+    sharedLibrary->frames[page] = -1;
+    sharedLibrary->resident--;
+    sharingStatistics.libraryReclaims++;
+    return 1;
+}
+
+/**
+ * @brief Cria o processo filho copiando a tabela de paginas do pai: as paginas privadas residentes passam a
+ * apontar para os mesmos frames (copia na escrita) e as da biblioteca continuam mapeadas
+ *
+ * @param parent Processo pai
+ * @param pid Id do filho
+ * @param ram Memoria principal
+ * @return Process* Processo filho
+ */
+Process* forkProcess(Process *parent, int pid, RAM *ram){
+    Process *child = createProcess(pid);
+    child->ppid = parent->pid;
+
+    for(int page = 0; page < NUM_PAGES; page++){
+        int frame = lookupPageTable(parent->workingSet->pageTable, virtualPageOf(parent, page));
+        if(frame == -1) continue;
+
+        if(isSharedPage(page)){
+            mapSharedPage(child, page, ram);
+            continue;
+        }
+        if(child->workingSet->remainingSlots == 0) continue;
+
+        addPageToWorkingSet(child, page, frame);
+        ram->refCount[frame]++;
+        sharingStatistics.inheritedPages++;
+    }
+    sharingStatistics.forks++;
+    return child;
+}
+
+/**
+ * @brief Registra a escrita em pagina herdada pelo fork
+ *
+ * @param copied 1 se a pagina foi copiada, 0 se o processo ja era o unico dono do frame
+ */
+void recordCopyOnWrite(int copied){
+    if(copied) sharingStatistics.cowCopies++;
+    else sharingStatistics.cowReuses++;
+}
+
+void printSharingStatistics(RAM *ram){
+    int usedFrames = 0, sharedFrames = 0;
+    long long mappings = 0;
+    for(int i = 0; i < FRAMES; i++){
+        if(!ram->refCount[i]) continue;
+        usedFrames++;
+        mappings += ram->refCount[i];
+        if(ram->refCount[i] > 1) sharedFrames++;
+    }
+
+    if(FORK_RATIO) printf("-> Fork: %lld processos criados por fork (%lld paginas herdadas), %lld copias na escrita, %lld escritas sem copia\n", sharingStatistics.forks, sharingStatistics.inheritedPages, sharingStatistics.cowCopies, sharingStatistics.cowReuses);
+    if(SHARED_PAGES) printf("-> Biblioteca (%d paginas, %d no page cache): %lld acertos, %lld faltas mapeadas do page cache, %lld lidas, %lld retiradas de todos os processos (%lld mapeamentos desfeitos pelo mapa reverso)\n", SHARED_PAGES, sharedLibrary->resident, sharingStatistics.libraryHits, sharingStatistics.libraryMinorFaults, sharingStatistics.libraryMajorFaults, sharingStatistics.libraryReclaims, sharingStatistics.rmapUnmaps);
+    printf("-> Frames compartilhados: %d de %d em uso, %lld referencias (%lld frames economizados)\n", sharedFrames, usedFrames, mappings, mappings - usedFrames);
+}
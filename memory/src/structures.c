@@ -1,12 +1,30 @@
 #include "../headers/structures.h"
+#include "../headers/replacement.h"
+#include "../headers/trace.h"
+#include "../headers/loadcontrol.h"
+#include "../headers/tlb.h"
+#include "../headers/swap.h"
+#include "../headers/cache.h"
 
 int readPageFromWorkingSet(Process *process, int pageNumber);
 Process* createProcess(int pid);
+PageMap* createPageMap();
+int translatePage(Process *process, long long virtualPage);
+int nextProcessPage(Process *process);
+long long virtualPageOf(Process *process, int pageNumber);
 RAM* createRam();
+void createMemoryNode(MemoryNode *node, int base, int frames, int colors);
+void createFrameBin(FrameBin *bin, int first, int stride, int frames);
+void resizeResidentSet(Process *process, int delta);
 void addPageToWorkingSet(Process *process, int pageNumber, int address);
-PageValues removeLeastUsedPage(Process *process);
+PageValues removeVictimPage(Process *process, int incomingPage);
+PageValues removeExpiredPage(Process *process);
 void removePageFromRAM(RAM *ram, int page);
 int addPageToRAM(RAM *ram);
+int addPageToNode(RAM *ram, int node, int color);
+int addPageToBin(FrameBin *bin);
+int nodeOfFrame(RAM *ram, int frame);
+int frameMappings(RAM *ram, int frame);
 int isRAMFull(RAM *ram);
 int isWSEmpty(Process *process);
 void printTLB(Process *process);
@@ -24,21 +42,99 @@ Process* createProcess(int pid){
     }
 
     process->pid = pid;
+    process->ppid = -1;
+    process->status = PROCESS_READY;
+    process->priority = TRACE_FILE ? 0 : rand() % PROCESS_PRIORITIES;
+    process->windowReferences = 0;
+    process->windowFaults = 0;
+    process->faultRate = 0;
     process->workingSet = (WS *)malloc(sizeof(WS));
 
     if(process->workingSet == NULL){
         exit(PROCESS_CREATION_ERROR);
     }
 
-    process->workingSet->head = NULL;
-    process->workingSet->tail = NULL;
-    process->workingSet->remainingSlots = WORKING_SET_LIMIT;
+    // No modelo de working set o conjunto residente varia com a janela, limitado apenas pela memoria
+    process->workingSet->limit = REPLACEMENT_POLICY == POLICY_WORKING_SET ? NUM_PAGES : WORKING_SET_LIMIT;
+    process->workingSet->remainingSlots = process->workingSet->limit;
+    process->workingSet->pageTable = createPageTable();
+    process->pageMap = TRACE_FILE ? createPageMap() : NULL;
+    process->generator = TRACE_FILE ? NULL : createGenerator(pid);
+    process->workingSet->policyState = replacementPolicy()->create(process);
 
-    for(int i = 0; i < NUM_PAGES; i++){
-        process->workingSet->rows[i] = -1;
+    return process;
+}
+
+/**
+ * @brief Cria a tabela de traducao de paginas virtuais com capacidade para NUM_PAGES paginas
+ * 
+ * @return PageMap* Tabela criada
+ */
+PageMap* createPageMap(){
+    PageMap *map = (PageMap *)malloc(sizeof(PageMap));
+    if(map == NULL){
+        exit(PROCESS_CREATION_ERROR);
     }
 
-    return process;
+    // Ocupacao maxima de 50% para manter as sondagens curtas
+    map->capacity = 1;
+    while(map->capacity < 2 * NUM_PAGES) map->capacity <<= 1;
+    map->keys = (long long *)malloc(sizeof(long long) * map->capacity);
+    map->values = (int *)malloc(sizeof(int) * map->capacity);
+    map->virtualPages = (long long *)malloc(sizeof(long long) * NUM_PAGES);
+    if(!map->keys || !map->values || !map->virtualPages){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < map->capacity; i++) map->keys[i] = -1;
+    map->size = 0;
+    return map;
+}
+
+/**
+ * @brief Traduz a pagina virtual do trace na pagina do processo, atribuindo a proxima livre no primeiro acesso
+ * 
+ * @param process Processo
+ * @param virtualPage Pagina virtual
+ * @return int Pagina do processo
+ */
+int translatePage(Process *process, long long virtualPage){
+    PageMap *map = process->pageMap;
+    unsigned long long hash = (unsigned long long)virtualPage * 0x9E3779B97F4A7C15ULL;
+    int slot = hash >> 32 & (map->capacity - 1);
+
+    while(map->keys[slot] != -1){
+        if(map->keys[slot] == virtualPage) return map->values[slot];
+        slot = (slot + 1) & (map->capacity - 1);
+    }
+
+    if(map->size == NUM_PAGES) exitProgram(OVER_MAX, "O trace usa mais paginas que permitido, aumente o limite com -v");
+    map->keys[slot] = virtualPage;
+    map->values[slot] = map->size;
+    map->virtualPages[map->size] = virtualPage;
+    return map->size++;
+}
+
+/**
+ * @brief Proxima pagina referenciada pelo processo: a da referencia do trace que esta sendo simulada ou a do gerador sintetico
+ * 
+ * @param process Processo
+ * @return int Pagina do processo
+ */
+int nextProcessPage(Process *process){
+    if(!process->pageMap) return nextGeneratedPage(process->generator);
+    return translatePage(process, currentTracePage());
+}
+
+/**
+ * @brief Pagina virtual que indexa a tabela de paginas: a do trace ou o proprio numero da pagina
+ * 
+ * @param process Processo
+ * @param pageNumber Pagina do processo
+ * @return long long Pagina virtual
+ */
+long long virtualPageOf(Process *process, int pageNumber){
+    return process->pageMap ? process->pageMap->virtualPages[pageNumber] : pageNumber;
 }
 
 /**
@@ -54,38 +150,151 @@ RAM* createRam(){
     }
 
     ram->remainingSlots = FRAMES;
-    for(int i = 0; i < FRAMES; i++){
-        ram->addresses[i] = 0;
+    // Sem compartilhamento cada frame em uso tem um unico mapeamento e o contador nao e alocado; com ele,
+    // um frame tem no maximo o page cache e MAX_PROCESSES mapeamentos
+    ram->refCount = NULL;
+    if(SHARED_PAGES || FORK_RATIO){
+        ram->refCount = (unsigned char *)calloc(FRAMES, sizeof(unsigned char));
+        if(!ram->refCount){
+            exit(RAM_CREATION_ERROR);
+        }
+    }
+
+    // Os frames sao divididos em faixas continuas entre os nos
+    ram->numNodes = NUMA_NODES ? NUMA_NODES : 1;
+    ram->numColors = PAGE_COLORING ? pageColors() : 1;
+    for(int i = 0; i < ram->numNodes; i++){
+        int base = (long long)FRAMES * i / ram->numNodes;
+        int end = (long long)FRAMES * (i + 1) / ram->numNodes;
+        createMemoryNode(&ram->nodes[i], base, end - base, ram->numColors);
     }
     
     return ram;
 }
 
 /**
- * @brief Remove a pagina menos recentemente usada do WS do processo
+ * @brief Cria um bitmap de frames livres para cada cor do no
+ * 
+ * @param node No de memoria
+ * @param base Primeiro frame do no
+ * @param frames Quantidade de frames do no
+ * @param colors Quantidade de cores
+ */
+void createMemoryNode(MemoryNode *node, int base, int frames, int colors){
+    node->base = base;
+    node->frames = frames;
+    node->remainingSlots = frames;
+    node->bins = (FrameBin *)malloc(sizeof(FrameBin) * colors);
+    if(!node->bins){
+        exit(RAM_CREATION_ERROR);
+    }
+
+    for(int color = 0; color < colors; color++){
+        int first = base + ((color - base % colors) + colors) % colors;
+        int binFrames = first < base + frames ? (base + frames - first + colors - 1) / colors : 0;
+        createFrameBin(&node->bins[color], first, colors, binFrames);
+    }
+}
+
+/**
+ * @brief Cria o bitmap de frames livres dos frames first, first+stride...
+ * 
+ * @param bin Bitmap
+ * @param first Primeiro frame
+ * @param stride Distancia entre dois frames seguidos do bitmap
+ * @param frames Quantidade de frames
+ */
+void createFrameBin(FrameBin *bin, int first, int stride, int frames){
+    bin->first = first;
+    bin->stride = stride;
+    bin->frames = frames;
+    bin->remainingSlots = frames;
+
+    // Cada nivel tem um bit por palavra do nivel abaixo, ate restar uma unica palavra
+    int bits = frames;
+    bin->numLevels = 0;
+    do{
+        if(bin->numLevels == FRAME_BITMAP_LEVELS) exit(RAM_CREATION_ERROR);
+
+        int words = (bits + 63) / 64;
+        unsigned long long *level = (unsigned long long *)malloc(sizeof(unsigned long long) * (words ? words : 1));
+        if(!level){
+            exit(RAM_CREATION_ERROR);
+        }
+
+        // Todos os bits validos comecam livres
+        for(int i = 0; i < words; i++) level[i] = ~0ULL;
+        if(bits % 64) level[words - 1] = (1ULL << (bits % 64)) - 1;
+
+        bin->freeFrames[bin->numLevels] = level;
+        bin->levelWords[bin->numLevels] = words;
+        bin->numLevels++;
+        bits = words;
+    }while(bits > 1);
+}
+
+/**
+ * @brief Remove a pagina escolhida pela politica de substituicao do WS do processo
  * 
  * @param process Processo
+ * @param incomingPage Pagina que vai entrar no WS (-1 se nenhuma)
  * @return PageValues Endereco e pagina virtual da pagina removida
  */
-PageValues removeLeastUsedPage(Process *process){
-    int page = process->workingSet->head->pageNumber;
-    int address = process->workingSet->rows[page];
+PageValues removeVictimPage(Process *process, int incomingPage){
+    int page = replacementPolicy()->chooseVictim(process->workingSet->policyState, incomingPage);
+    long long virtualPage = virtualPageOf(process, page);
+    int address = lookupPageTable(process->workingSet->pageTable, virtualPage);
 
     PageValues pv;
     pv.address = address;
     pv.page = page;
     
-    PageElement *aux = process->workingSet->head;
-    process->workingSet->head = process->workingSet->head->next;
-    free(aux);
-    if(process->workingSet->head) process->workingSet->head->prev = NULL;
+    invalidateTLBEntry(process->pid, page);
+    swapOutPage(process->pid, page);
     process->workingSet->remainingSlots++;
+    unmapPage(process->workingSet->pageTable, virtualPage);
 
-    process->workingSet->rows[page] = -1;
+    return pv;
+}
 
+/**
+ * @brief Remove do conjunto residente a proxima pagina que saiu do working set
+ * 
+ * @param process Processo
+ * @return PageValues Endereco e pagina removida (pagina -1 se nenhuma)
+ */
+PageValues removeExpiredPage(Process *process){
+    PageValues pv;
+    pv.page = -1;
+    pv.address = -1;
+
+    ReplacementPolicy *policy = replacementPolicy();
+    if(!policy->nextExpired) return pv;
+
+    pv.page = policy->nextExpired(process->workingSet->policyState);
+    if(pv.page == -1) return pv;
+
+    long long virtualPage = virtualPageOf(process, pv.page);
+    pv.address = lookupPageTable(process->workingSet->pageTable, virtualPage);
+    invalidateTLBEntry(process->pid, pv.page);
+    swapOutPage(process->pid, pv.page);
+    process->workingSet->remainingSlots++;
+    unmapPage(process->workingSet->pageTable, virtualPage);
     return pv;
 }
 
+/**
+ * @brief Altera o limite de paginas residentes do processo. Para encolher, o processo deve ter um espaco livre
+ * 
+ * @param process Processo
+ * @param delta Variacao do limite
+ */
+void resizeResidentSet(Process *process, int delta){
+    process->workingSet->limit += delta;
+    process->workingSet->remainingSlots += delta;
+    if(replacementPolicy()->resize) replacementPolicy()->resize(process->workingSet->policyState, process->workingSet->limit);
+}
+
 /**
  * @brief Adiciona uma pagina do working set do processo
  * 
@@ -94,22 +303,9 @@ PageValues removeLeastUsedPage(Process *process){
  * @param address Endereco a ser adicionado
  */
 void addPageToWorkingSet(Process *process, int pageNumber, int address){
-    if(process->workingSet->head == NULL){
-        process->workingSet->head = (PageElement *)malloc(sizeof(PageElement));
-        process->workingSet->tail = process->workingSet->head;
-        process->workingSet->tail->next = NULL;
-        process->workingSet->tail->prev = NULL;
-    }else{
-        process->workingSet->tail->next = (PageElement *)malloc(sizeof(PageElement));
-        process->workingSet->tail->next->prev = process->workingSet->tail;
-        process->workingSet->tail->next->next = NULL;
-        process->workingSet->tail = process->workingSet->tail->next;
-    }
-    
     process->workingSet->remainingSlots--;
-    process->workingSet->tail->pageNumber = pageNumber;
-
-    process->workingSet->rows[pageNumber] = address;
+    mapPage(process->workingSet->pageTable, virtualPageOf(process, pageNumber), address);
+    replacementPolicy()->onMiss(process->workingSet->policyState, pageNumber);
 }
 
 /**
@@ -120,48 +316,118 @@ void addPageToWorkingSet(Process *process, int pageNumber, int address){
  * @return int Endereco da pagina lida ou -1 se pagina nao encontrada
  */
 int readPageFromWorkingSet(Process *process, int pageNumber){
-    PageElement *element = process->workingSet->head;
-    while(element != NULL){
-        if(element->pageNumber == pageNumber){
-            // Retira elemento da lista
-            if(element->prev) element->prev->next = element->next;
-            else process->workingSet->head = element->next;
-
-            if(element->next) element->next->prev = element->prev;
-            else process->workingSet->tail = process->workingSet->tail->prev;
-
-            // Adiciona no final
-            if(process->workingSet->head == NULL){
-                process->workingSet->head = element;
-                element->prev = NULL;
-            }else{
-                process->workingSet->tail->next = element;
-                element->prev = process->workingSet->tail;
-            }
-            element->next = NULL;
-            process->workingSet->tail = element;
-
-            return process->workingSet->rows[pageNumber];
-        }
-        element = element->next;
-    }
-    return -1;
+    int address = lookupPageTable(process->workingSet->pageTable, virtualPageOf(process, pageNumber));
+    if(address == -1) return -1;
+
+    replacementPolicy()->onHit(process->workingSet->policyState, pageNumber);
+    return address;
 }
 
+/**
+ * @brief Aloca o frame livre de menor endereco, sem preferencia de cor
+ * 
+ * @param ram Memoria principal
+ * @return int Endereco do frame alocado ou -1 se a memoria estiver cheia
+ */
 int addPageToRAM(RAM *ram){
-    for(int i = 0; i < FRAMES; i++){
-        if(ram->addresses[i] == 0){
-            ram->addresses[i] = 1;
-            ram->remainingSlots--;
-            return i;
-        }
+    for(int i = 0; i < ram->numNodes; i++){
+        int frame = addPageToNode(ram, i, 0);
+        if(frame != -1) return frame;
     }
     return -1;
 }
 
+/**
+ * @brief Aloca um frame livre do no, da cor pedida ou, se ela estiver esgotada no no, da proxima cor com
+ * frames livres
+ * 
+ * @param ram Memoria principal
+ * @param node No de memoria
+ * @param color Cor preferida (0 sem coloracao)
+ * @return int Endereco do frame alocado ou -1 se o no estiver cheio
+ */
+int addPageToNode(RAM *ram, int node, int color){
+    MemoryNode *memoryNode = &ram->nodes[node];
+    if(memoryNode->remainingSlots == 0) return -1;
+
+    FrameBin *bin = &memoryNode->bins[color];
+    while(bin->remainingSlots == 0){
+        color = (color + 1) % ram->numColors;
+        bin = &memoryNode->bins[color];
+    }
+
+    int index = addPageToBin(bin);
+    if(ram->refCount) ram->refCount[index] = 1;
+    memoryNode->remainingSlots--;
+    ram->remainingSlots--;
+    return index;
+}
+
+/**
+ * @brief Ocupa o frame livre de menor endereco do bitmap, descendo pelos niveis
+ * 
+ * @param bin Bitmap com frames livres
+ * @return int Endereco do frame
+ */
+int addPageToBin(FrameBin *bin){
+    int index = 0;
+    for(int level = bin->numLevels - 1; level >= 0; level--){
+        index = index * 64 + __builtin_ctzll(bin->freeFrames[level][index]);
+    }
+
+    // Marca como ocupado e propaga para cima enquanto a palavra ficar sem frames livres
+    int position = index;
+    for(int level = 0; level < bin->numLevels; level++){
+        unsigned long long *word = &bin->freeFrames[level][position / 64];
+        *word &= ~(1ULL << (position % 64));
+        if(*word) break;
+        position /= 64;
+    }
+
+    bin->remainingSlots--;
+    return bin->first + index * bin->stride;
+}
+
+/**
+ * @brief No de memoria que contem o frame
+ */
+int nodeOfFrame(RAM *ram, int frame){
+    int node = ram->numNodes - 1;
+    while(ram->nodes[node].base > frame) node--;
+    return node;
+}
+
+/**
+ * @brief Mapeamentos do frame em uso; sem o contador, cada frame tem um unico mapeamento
+ */
+int frameMappings(RAM *ram, int frame){
+    return ram->refCount ? ram->refCount[frame] : 1;
+}
+
+/**
+ * @brief Desfaz um mapeamento do frame. Sem mapeamentos, o frame e liberado no bitmap do seu no e da sua cor,
+ * propagando para cima enquanto a palavra estava sem frames livres, e as suas linhas saem das caches
+ * 
+ * @param ram Memoria principal
+ * @param page Endereco do frame
+ */
 void removePageFromRAM(RAM *ram, int page){
-    ram->addresses[page] = 0;
+    if(ram->refCount && --ram->refCount[page] > 0) return;
+
+    MemoryNode *memoryNode = &ram->nodes[nodeOfFrame(ram, page)];
+    FrameBin *bin = &memoryNode->bins[page % ram->numColors];
+    int position = (page - bin->first) / bin->stride;
+    for(int level = 0; level < bin->numLevels; level++){
+        unsigned long long *word = &bin->freeFrames[level][position / 64];
+        int wasEmpty = *word == 0;
+        *word |= 1ULL << (position % 64);
+        if(!wasEmpty) break;
+        position /= 64;
+    }
+    bin->remainingSlots++;
+    memoryNode->remainingSlots++;
     ram->remainingSlots++;
+    if(CACHE_SIZE) invalidateFrameCaches(page);
 }
 
 int isRAMFull(RAM *ram){
@@ -169,17 +435,12 @@ int isRAMFull(RAM *ram){
 }
 
 int isWSEmpty(Process *process){
-    return process->workingSet->head == NULL;
+    return process->workingSet->remainingSlots == process->workingSet->limit;
 }
 
 void printTLB(Process *process){
     printf("-------\n");
     printf("| P%-2d |\n",process->pid);
     printf("-------\n");
-    for(int i = 0; i < NUM_PAGES; i++){
-        int address = process->workingSet->rows[i];
-        if(address == -1) continue;
-        printf("|%02d|%02d|\n", i, address);
-        printf("-------\n");
-    }
+    printPageTable(process->workingSet->pageTable, process->pageMap != NULL);
 }
@@ -0,0 +1,215 @@
+#include "../headers/swap.h"
+#include "../headers/zswap.h"
+
+SwapDevice *swapDevice = NULL;
+SwapSpace *swapSpaces[MAX_PROCESSES];
+SwapStatistics swapStatistics;
+
+void createSwapDevice();
+SwapSpace* swapSpaceOf(int pid);
+long long submitSwapRequest(long long latency);
+void recordFaultLatency(long long latency);
+void readAhead(Process *process, SwapSpace *space, int pageNumber);
+void recordSwapReference(Process *process, int pageNumber, int write, int fault);
+void swapOutPage(int pid, int pageNumber);
+void writeSwapPage(int pid, int pageNumber);
+double latencyPercentile(double fraction);
+void printSwapStatistics();
+
+void createSwapDevice(){
+    swapDevice = (SwapDevice *)calloc(1, sizeof(SwapDevice));
+    if(swapDevice == NULL){
+        exit(RAM_CREATION_ERROR);
+    }
+}
+
+/**
+ * @brief Estado de swap do processo, criado na primeira referencia
+ */
+SwapSpace* swapSpaceOf(int pid){
+    if(swapSpaces[pid]) return swapSpaces[pid];
+
+    SwapSpace *space = (SwapSpace *)malloc(sizeof(SwapSpace));
+    if(space == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    int words = (NUM_PAGES + 63) / 64;
+    space->dirty = (unsigned long long *)calloc(words, sizeof(unsigned long long));
+    space->swapped = (unsigned long long *)calloc(words, sizeof(unsigned long long));
+    space->readyAt = (long long *)malloc(sizeof(long long) * NUM_PAGES);
+    if(!space->dirty || !space->swapped || !space->readyAt){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    for(int i = 0; i < NUM_PAGES; i++) space->readyAt[i] = -1;
+    space->lastFault = -2;
+    swapSpaces[pid] = space;
+    return space;
+}
+
+/**
+ * @brief Coloca um pedido na posicao da fila que fica livre primeiro
+ *
+ * @param latency Tempo de servico do pedido (ns)
+ * @return long long Instante em que o pedido termina
+ */
+long long submitSwapRequest(long long latency){
+    int slot = 0;
+    for(int i = 1; i < SWAP_QUEUE_DEPTH; i++){
+        if(swapDevice->busyUntil[i] < swapDevice->busyUntil[slot]) slot = i;
+    }
+
+    long long start = swapDevice->busyUntil[slot];
+    if(start > swapDevice->clock){
+        swapStatistics.queueWaits++;
+    }else{
+        start = swapDevice->clock;
+    }
+    swapDevice->busyUntil[slot] = start + latency;
+    return start + latency;
+}
+
+void recordFaultLatency(long long latency){
+    swapStatistics.faultTime += latency;
+    if(latency > swapStatistics.maxFaultTime) swapStatistics.maxFaultTime = latency;
+
+    long long bucket = latency / 1000;
+    swapStatistics.histogram[bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1]++;
+}
+
+/**
+ * @brief Le de forma assincrona as proximas SWAP_READAHEAD paginas que estao no swap, para o swap cache
+ *
+ * @param process Processo
+ * @param space Estado de swap do processo
+ * @param pageNumber Pagina da falta sequencial
+ */
+void readAhead(Process *process, SwapSpace *space, int pageNumber){
+    long long latency = SWAP_READ_LATENCY * 1000LL;
+    for(int page = pageNumber + 1; page <= pageNumber + SWAP_READAHEAD && page < NUM_PAGES; page++){
+        if(!(space->swapped[page / 64] >> (page % 64) & 1) || space->readyAt[page] != -1) continue;
+        if(lookupPageTable(process->workingSet->pageTable, virtualPageOf(process, page)) != -1) continue;
+
+        space->readyAt[page] = submitSwapRequest(latency);
+        swapStatistics.readaheadPages++;
+    }
+}
+
+/**
+ * @brief Avanca o tempo simulado de uma referencia. Na falta, a pagina vem do pool comprimido, do swap cache,
+ * do dispositivo (o processo espera a leitura, inclusive a fila) ou nao precisa de leitura
+ *
+ * @param process Processo
+ * @param pageNumber Pagina referenciada, ja na memoria
+ * @param write Se a referencia e uma escrita
+ * @param fault Se a referencia teve falta de pagina
+ */
+void recordSwapReference(Process *process, int pageNumber, int write, int fault){
+    SwapSpace *space = swapSpaceOf(process->pid);
+    swapDevice->clock += REFERENCE_TIME;
+    swapStatistics.references++;
+
+    if(fault){
+        long long latency = 0;
+        int fromSwap = 1;
+        if(ZSWAP_PERCENT && loadCompressedPage(process->pid, pageNumber)){
+            // A copia comprimida deixa de existir, entao a pagina tera que ser guardada de novo
+            swapStatistics.compressedHits++;
+            latency = ZSWAP_DECOMPRESS_TIME;
+            space->dirty[pageNumber / 64] |= 1ULL << (pageNumber % 64);
+            fromSwap = 0;
+        }else if(space->readyAt[pageNumber] != -1){
+            swapStatistics.readaheadHits++;
+            if(space->readyAt[pageNumber] > swapDevice->clock) latency = space->readyAt[pageNumber] - swapDevice->clock;
+            space->readyAt[pageNumber] = -1;
+        }else if(space->swapped[pageNumber / 64] >> (pageNumber % 64) & 1){
+            swapStatistics.majorFaults++;
+            latency = submitSwapRequest(SWAP_READ_LATENCY * 1000LL) - swapDevice->clock;
+        }else{
+            swapStatistics.minorFaults++;
+            fromSwap = 0;
+        }
+
+        if(fromSwap && SWAP_READAHEAD && pageNumber == space->lastFault + 1) readAhead(process, space, pageNumber);
+        space->lastFault = pageNumber;
+        swapDevice->clock += latency;
+        recordFaultLatency(latency);
+    }
+
+    if(write) space->dirty[pageNumber / 64] |= 1ULL << (pageNumber % 64);
+}
+
+/**
+ * @brief Pagina saindo da memoria: se suja, e comprimida no pool ou gravada no swap sem bloquear o processo,
+ * ocupando a fila
+ *
+ * @param pid Processo
+ * @param pageNumber Pagina removida
+ */
+void swapOutPage(int pid, int pageNumber){
+    if(!swapDevice) return;
+
+    SwapSpace *space = swapSpaceOf(pid);
+    unsigned long long bit = 1ULL << (pageNumber % 64);
+    if(!(space->dirty[pageNumber / 64] & bit)){
+        swapStatistics.cleanEvictions++;
+        return;
+    }
+
+    space->dirty[pageNumber / 64] &= ~bit;
+    if(ZSWAP_PERCENT){
+        swapDevice->clock += ZSWAP_COMPRESS_TIME;
+        if(storeCompressedPage(pid, pageNumber)){
+            // A copia antiga no swap, se houver, ficou desatualizada
+            space->swapped[pageNumber / 64] &= ~bit;
+            return;
+        }
+    }
+    writeSwapPage(pid, pageNumber);
+}
+
+/**
+ * @brief Grava a pagina no swap de forma assincrona
+ *
+ * @param pid Processo
+ * @param pageNumber Pagina
+ */
+void writeSwapPage(int pid, int pageNumber){
+    swapSpaceOf(pid)->swapped[pageNumber / 64] |= 1ULL << (pageNumber % 64);
+    submitSwapRequest(SWAP_WRITE_LATENCY * 1000LL);
+    swapStatistics.writebacks++;
+}
+
+/**
+ * @brief Limite superior da faixa do histograma que contem o percentil
+ *
+ * @param fraction Percentil entre 0 e 1
+ * @return double Latencia em microssegundos
+ */
+double latencyPercentile(double fraction){
+    long long total = 0;
+    for(int i = 0; i < LATENCY_BUCKETS; i++) total += swapStatistics.histogram[i];
+
+    long long seen = 0;
+    for(int i = 0; i < LATENCY_BUCKETS; i++){
+        seen += swapStatistics.histogram[i];
+        if(seen && seen >= fraction * total) return i == LATENCY_BUCKETS - 1 ? swapStatistics.maxFaultTime / 1000.0 : i + 1;
+    }
+    return 0;
+}
+
+void printSwapStatistics(){
+    long long faults = swapStatistics.compressedHits + swapStatistics.majorFaults + swapStatistics.minorFaults + swapStatistics.readaheadHits;
+    double references = swapStatistics.references ? (double)swapStatistics.references : 1;
+    double seconds = swapDevice->clock / 1e9;
+    double megabytes = VIRTUAL_PAGE_SIZE / 1e6;
+
+    printf("-> Swap: leitura %d us, escrita %d us, fila %d, leitura antecipada de %d paginas\n", SWAP_READ_LATENCY, SWAP_WRITE_LATENCY, SWAP_QUEUE_DEPTH, SWAP_READAHEAD);
+    printf("-> Faltas: %lld no zswap, %lld lidas do swap, %lld sem leitura, %lld no swap cache (%lld paginas lidas antecipadamente)\n", swapStatistics.compressedHits, swapStatistics.majorFaults, swapStatistics.minorFaults, swapStatistics.readaheadHits, swapStatistics.readaheadPages);
+    printf("-> Camadas: memoria %.2f%%, zswap %.2f%%, swap cache %.2f%%, dispositivo %.2f%%, sem leitura %.2f%% das referencias\n", 100.0 * (swapStatistics.references - faults) / references, 100.0 * swapStatistics.compressedHits / references, 100.0 * swapStatistics.readaheadHits / references, 100.0 * swapStatistics.majorFaults / references, 100.0 * swapStatistics.minorFaults / references);
+    printf("-> Latencia das faltas: media %.1f us, p50 ate %.1f us, p99 ate %.1f us, maxima %.1f us, %lld pedidos esperaram a fila\n", faults ? swapStatistics.faultTime / 1000.0 / faults : 0, latencyPercentile(0.5), latencyPercentile(0.99), swapStatistics.maxFaultTime / 1000.0, swapStatistics.queueWaits);
+    printf("-> Paginas retiradas: %lld sujas gravadas no swap, %lld limpas descartadas\n", swapStatistics.writebacks, swapStatistics.cleanEvictions);
+    printf("-> Tempo simulado: %.3fs (%.1f%% esperando faltas), leitura %.1f MB/s, escrita %.1f MB/s\n", seconds, seconds > 0 ? 100.0 * swapStatistics.faultTime / swapDevice->clock : 0, seconds > 0 ? (swapStatistics.majorFaults + swapStatistics.readaheadPages) * megabytes / seconds : 0, seconds > 0 ? swapStatistics.writebacks * megabytes / seconds : 0);
+    if(ZSWAP_PERCENT) printZswapStatistics();
+}
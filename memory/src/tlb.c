@@ -0,0 +1,160 @@
+#include "../headers/tlb.h"
+#include "../headers/pagetable.h"
+
+TLBLevel *l1TLB = NULL;
+TLBLevel *l2TLB = NULL;
+TLBStatistics tlbStatistics;
+int currentAsid = -1;
+
+void createTLB();
+TLBLevel* createTLBLevel(int entries, int ways);
+int lookupTLBLevel(TLBLevel *tlb, int asid, int page);
+void fillTLBLevel(TLBLevel *tlb, int asid, int page);
+void flushTLBLevel(TLBLevel *tlb);
+int invalidateTLBLevel(TLBLevel *tlb, int asid, int page);
+int accessTLB(int asid, int page);
+void invalidateTLBEntry(int asid, int page);
+void printTLBStatistics();
+
+/**
+ * @brief Cria os niveis da TLB configurados na linha de comando
+ */
+void createTLB(){
+    l1TLB = createTLBLevel(TLB_ENTRIES, TLB_WAYS);
+    if(TLB_L2_ENTRIES) l2TLB = createTLBLevel(TLB_L2_ENTRIES, TLB_L2_WAYS);
+}
+
+TLBLevel* createTLBLevel(int entries, int ways){
+    TLBLevel *tlb = (TLBLevel *)malloc(sizeof(TLBLevel));
+    if(tlb == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    tlb->sets = entries / ways;
+    tlb->ways = ways;
+    tlb->pages = (long long *)malloc(sizeof(long long) * entries);
+    tlb->asids = (int *)malloc(sizeof(int) * entries);
+    tlb->stamps = (long long *)calloc(entries, sizeof(long long));
+    if(!tlb->pages || !tlb->asids || !tlb->stamps){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    tlb->clock = 0;
+    flushTLBLevel(tlb);
+    return tlb;
+}
+
+/**
+ * @brief Procura a pagina no conjunto dela
+ *
+ * @return int Indice da entrada ou -1 se nao encontrada
+ */
+int lookupTLBLevel(TLBLevel *tlb, int asid, int page){
+    int first = page % tlb->sets * tlb->ways;
+    for(int entry = first; entry < first + tlb->ways; entry++){
+        if(tlb->pages[entry] == page && tlb->asids[entry] == asid){
+            if(TLB_REPLACEMENT == TLB_LRU) tlb->stamps[entry] = ++tlb->clock;
+            return entry;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Insere a traducao no conjunto da pagina, ocupando uma via invalida ou substituindo uma pela politica da TLB
+ */
+void fillTLBLevel(TLBLevel *tlb, int asid, int page){
+    int first = page % tlb->sets * tlb->ways;
+    int victim = -1;
+    for(int entry = first; entry < first + tlb->ways; entry++){
+        if(tlb->pages[entry] == -1){
+            victim = entry;
+            break;
+        }
+        if(victim == -1 || tlb->stamps[entry] < tlb->stamps[victim]) victim = entry;
+    }
+    if(TLB_REPLACEMENT == TLB_RANDOM && tlb->pages[victim] != -1) victim = first + rand() % tlb->ways;
+
+    tlb->pages[victim] = page;
+    tlb->asids[victim] = asid;
+    tlb->stamps[victim] = ++tlb->clock;
+}
+
+void flushTLBLevel(TLBLevel *tlb){
+    for(int entry = 0; entry < tlb->sets * tlb->ways; entry++) tlb->pages[entry] = -1;
+}
+
+int invalidateTLBLevel(TLBLevel *tlb, int asid, int page){
+    int entry = lookupTLBLevel(tlb, asid, page);
+    if(entry == -1) return 0;
+
+    tlb->pages[entry] = -1;
+    return 1;
+}
+
+/**
+ * @brief Traduz a pagina pela TLB: L1, depois L2 e, se ambas falharem, percorre a tabela de paginas
+ * e preenche os niveis. Sem ASID, a troca de processo esvazia a TLB
+ *
+ * @param asid Processo dono da pagina
+ * @param page Pagina do processo
+ * @return int TLB_L1_HIT, TLB_L2_HIT ou TLB_MISS
+ */
+int accessTLB(int asid, int page){
+    if(asid != currentAsid){
+        if(currentAsid != -1 && !TLB_ASID){
+            flushTLBLevel(l1TLB);
+            if(l2TLB) flushTLBLevel(l2TLB);
+            tlbStatistics.flushes++;
+        }
+        currentAsid = asid;
+    }
+
+    tlbStatistics.lookups++;
+    tlbStatistics.cycles += TLB_L1_LATENCY + MEMORY_LATENCY;
+    if(lookupTLBLevel(l1TLB, asid, page) != -1){
+        tlbStatistics.l1Hits++;
+        return TLB_L1_HIT;
+    }
+
+    if(l2TLB){
+        tlbStatistics.cycles += TLB_L2_LATENCY;
+        if(lookupTLBLevel(l2TLB, asid, page) != -1){
+            tlbStatistics.l2Hits++;
+            fillTLBLevel(l1TLB, asid, page);
+            return TLB_L2_HIT;
+        }
+    }
+
+    tlbStatistics.pageWalks++;
+    tlbStatistics.cycles += pageTableDepth() * MEMORY_LATENCY;
+    if(l2TLB) fillTLBLevel(l2TLB, asid, page);
+    fillTLBLevel(l1TLB, asid, page);
+    return TLB_MISS;
+}
+
+/**
+ * @brief Derruba a traducao de uma pagina retirada da memoria em todos os niveis
+ *
+ * @param asid Processo dono da pagina
+ * @param page Pagina do processo
+ */
+void invalidateTLBEntry(int asid, int page){
+    if(!l1TLB) return;
+
+    tlbStatistics.invalidations += invalidateTLBLevel(l1TLB, asid, page);
+    if(l2TLB) tlbStatistics.invalidations += invalidateTLBLevel(l2TLB, asid, page);
+}
+
+/**
+ * @brief Imprime as taxas de acerto da TLB e o tempo efetivo de acesso (sem contar as faltas de pagina)
+ */
+void printTLBStatistics(){
+    double lookups = tlbStatistics.lookups ? (double)tlbStatistics.lookups : 1;
+    long long l2Lookups = tlbStatistics.lookups - tlbStatistics.l1Hits;
+
+    printf("-> TLB: L1 %d entradas/%d vias com %.2f%% de acertos", TLB_ENTRIES, TLB_WAYS, 100.0 * tlbStatistics.l1Hits / lookups);
+    if(l2TLB) printf(", L2 %d entradas/%d vias com %.2f%% de acertos", TLB_L2_ENTRIES, TLB_L2_WAYS, l2Lookups ? 100.0 * tlbStatistics.l2Hits / l2Lookups : 0);
+    printf(", %s\n", TLB_ASID ? "com ASID" : "sem ASID");
+    printf("-> Page walks: %lld (%.2f%%, %d ciclos cada), flushes: %lld, invalidacoes: %lld, tempo efetivo de acesso: %.2f ciclos\n", tlbStatistics.pageWalks, 100.0 * tlbStatistics.pageWalks / lookups, pageTableDepth() * MEMORY_LATENCY, tlbStatistics.flushes, tlbStatistics.invalidations, tlbStatistics.cycles / lookups);
+}
@@ -0,0 +1,262 @@
+#include "../headers/trace.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Quantidade de bytes lidos antes de devolver ao kernel as paginas do trace ja processadas
+#define TRACE_RELEASE_CHUNK (64 * 1024 * 1024)
+
+// Menor tabela de ultimos usos do indice de proximos usos
+#define TRACE_USES_MIN_CAPACITY 65536
+
+typedef struct TraceUse TraceUse;
+
+// Ultima posicao em que a pagina do processo apareceu durante a indexacao
+struct TraceUse{
+    long long page;
+    int process; // -1 se a entrada esta livre
+    long long position;
+};
+
+char *traceData;
+size_t traceSize;
+int traceBinary;
+TraceCursor mainCursor;
+
+unsigned int tracePids[MAX_PROCESSES];
+int numTracePids = 0;
+
+// Referencia lida por ultimo pelo cursor principal e a sua posicao no trace
+TraceReference currentReference;
+long long currentPosition = -1;
+
+// Posicao da proxima referencia a mesma pagina do mesmo processo (NO_NEXT_USE se nenhuma), indexada com o OPT
+long long *traceNextUses;
+
+void openTrace(char *path);
+int traceProcessIndex(unsigned int pid);
+int decodeTextReference(TraceCursor *cursor, TraceReference *reference);
+int decodeBinaryReference(TraceCursor *cursor, TraceReference *reference);
+int decodeReference(TraceCursor *cursor, TraceReference *reference);
+void releaseTrace(TraceCursor *cursor);
+TraceUse* findTraceUse(TraceUse *uses, int capacity, int process, long long page);
+void indexTraceNextUses();
+int nextTraceReference(TraceReference *reference);
+long long currentTracePage();
+long long nextTraceUse();
+
+/**
+ * @brief Mapeia o arquivo de trace em memoria e identifica o formato
+ *
+ * @param path Caminho do arquivo
+ */
+void openTrace(char *path){
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) exitProgram(TRACE_ERROR, "Nao foi possivel abrir o arquivo de trace");
+
+    struct stat info;
+    if(fstat(fd, &info) < 0) exitProgram(TRACE_ERROR, "Nao foi possivel ler o arquivo de trace");
+    traceSize = info.st_size;
+    if(traceSize == 0) exitProgram(TRACE_ERROR, "Arquivo de trace vazio");
+
+    // O arquivo nunca e carregado inteiro: as paginas sao lidas sob demanda e descartadas depois de decodificadas
+    traceData = (char *)mmap(NULL, traceSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(traceData == MAP_FAILED) exitProgram(TRACE_ERROR, "Nao foi possivel mapear o arquivo de trace");
+    madvise(traceData, traceSize, MADV_SEQUENTIAL);
+
+    traceBinary = traceSize >= TRACE_MAGIC_SIZE && memcmp(traceData, TRACE_MAGIC, TRACE_MAGIC_SIZE) == 0;
+    mainCursor.offset = mainCursor.released = traceBinary ? TRACE_MAGIC_SIZE : 0;
+}
+
+/**
+ * @brief Indice do processo do trace, atribuido na ordem de aparicao
+ *
+ * @param pid Pid do trace
+ * @return int Indice do processo
+ */
+int traceProcessIndex(unsigned int pid){
+    for(int i = 0; i < numTracePids; i++){
+        if(tracePids[i] == pid) return i;
+    }
+
+    if(numTracePids == PROCESSES) exitProgram(OVER_MAX, "Mais processos no trace que permitido, aumente o limite com -p");
+    tracePids[numTracePids] = pid;
+    return numTracePids++;
+}
+
+/**
+ * @brief Decodifica a proxima linha no formato do Valgrind lackey ("I  addr,size", " L addr,size", " S addr,size" ou " M addr,size"),
+ * com o pid opcional no inicio da linha. Linhas em outro formato sao ignoradas
+ */
+int decodeTextReference(TraceCursor *cursor, TraceReference *reference){
+    while(cursor->offset < traceSize){
+        char *line = traceData + cursor->offset;
+        char *end = (char *)memchr(line, '\n', traceSize - cursor->offset);
+        if(!end) end = traceData + traceSize;
+        cursor->offset = end - traceData + 1;
+
+        char *s = line;
+        unsigned int pid = 0;
+        while(s < end && *s >= '0' && *s <= '9') pid = pid * 10 + (*s++ - '0');
+        while(s < end && *s == ' ') s++;
+        if(s >= end) continue;
+
+        char operation = *s++;
+        if(operation != 'I' && operation != 'L' && operation != 'S' && operation != 'M') continue;
+        if(s >= end || *s != ' ') continue;
+        while(s < end && *s == ' ') s++;
+
+        unsigned long long address = 0;
+        int digits = 0;
+        for(; s < end && *s != ','; s++, digits++){
+            int value;
+            if(*s >= '0' && *s <= '9') value = *s - '0';
+            else if(*s >= 'a' && *s <= 'f') value = *s - 'a' + 10;
+            else if(*s >= 'A' && *s <= 'F') value = *s - 'A' + 10;
+            else break;
+            address = address * 16 + value;
+        }
+        if(!digits || s >= end || *s != ',') continue;
+
+        reference->process = traceProcessIndex(pid);
+        reference->page = address / VIRTUAL_PAGE_SIZE;
+        reference->offset = address % VIRTUAL_PAGE_SIZE;
+        reference->write = operation == 'S' || operation == 'M';
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Decodifica o proximo registro do formato binario
+ */
+int decodeBinaryReference(TraceCursor *cursor, TraceReference *reference){
+    if(cursor->offset + sizeof(TraceRecord) > traceSize) return 0;
+
+    TraceRecord record;
+    memcpy(&record, traceData + cursor->offset, sizeof(TraceRecord));
+    cursor->offset += sizeof(TraceRecord);
+
+    reference->process = traceProcessIndex(record.pid);
+    reference->page = record.address / VIRTUAL_PAGE_SIZE;
+    reference->offset = record.address % VIRTUAL_PAGE_SIZE;
+    reference->write = record.flags & TRACE_WRITE;
+    return 1;
+}
+
+int decodeReference(TraceCursor *cursor, TraceReference *reference){
+    return traceBinary ? decodeBinaryReference(cursor, reference) : decodeTextReference(cursor, reference);
+}
+
+/**
+ * @brief Devolve ao kernel as paginas do trace que o cursor ja passou
+ */
+void releaseTrace(TraceCursor *cursor){
+    if(cursor->offset - cursor->released < TRACE_RELEASE_CHUNK) return;
+
+    long pageSize = sysconf(_SC_PAGESIZE);
+    size_t start = cursor->released / pageSize * pageSize;
+    size_t end = cursor->offset / pageSize * pageSize;
+    madvise(traceData + start, end - start, MADV_DONTNEED);
+    cursor->released = end;
+}
+
+/**
+ * @brief Entrada da tabela de ultimos usos da pagina do processo, ou a entrada livre onde ela deve ficar
+ */
+TraceUse* findTraceUse(TraceUse *uses, int capacity, int process, long long page){
+    unsigned long long hash = ((unsigned long long)page * MAX_PROCESSES + process) * 0x9E3779B97F4A7C15ULL;
+    int slot = (hash >> 32) & (capacity - 1);
+    while(uses[slot].process != -1 && (uses[slot].process != process || uses[slot].page != page)){
+        slot = (slot + 1) & (capacity - 1);
+    }
+    return &uses[slot];
+}
+
+/**
+ * @brief Le o trace uma vez antes da simulacao e guarda, para cada referencia, a posicao da proxima referencia
+ * a mesma pagina do mesmo processo. Assim o OPT conhece todo o futuro com 8 bytes por referencia, sem guardar
+ * as paginas. So as referencias ate o limite de ciclos sao indexadas, pois as outras nao sao simuladas
+ */
+void indexTraceNextUses(){
+    TraceCursor cursor = mainCursor;
+    TraceReference reference;
+
+    long long references = 0;
+    long long capacity = traceBinary ? (traceSize - TRACE_MAGIC_SIZE) / sizeof(TraceRecord) : TRACE_RELEASE_CHUNK / 32;
+    if(STOPPING_LIMIT != -1 && capacity > STOPPING_LIMIT) capacity = STOPPING_LIMIT;
+    if(capacity < 1) capacity = 1;
+    traceNextUses = (long long *)malloc(sizeof(long long) * capacity);
+
+    int usesCapacity = TRACE_USES_MIN_CAPACITY, numUses = 0;
+    TraceUse *uses = (TraceUse *)malloc(sizeof(TraceUse) * usesCapacity);
+    if(!traceNextUses || !uses) exitProgram(TRACE_ERROR, "Sem memoria para indexar o trace");
+    for(int i = 0; i < usesCapacity; i++) uses[i].process = -1;
+
+    while((STOPPING_LIMIT == -1 || references < STOPPING_LIMIT) && decodeReference(&cursor, &reference)){
+        releaseTrace(&cursor);
+        if(references == capacity){
+            capacity *= 2;
+            traceNextUses = (long long *)realloc(traceNextUses, sizeof(long long) * capacity);
+            if(!traceNextUses) exitProgram(TRACE_ERROR, "Sem memoria para indexar o trace");
+        }
+
+        // A tabela dobra com metade ocupada, reinserindo as paginas ja vistas
+        if(2 * (numUses + 1) > usesCapacity){
+            TraceUse *old = uses;
+            uses = (TraceUse *)malloc(sizeof(TraceUse) * 2 * usesCapacity);
+            if(!uses) exitProgram(TRACE_ERROR, "Sem memoria para indexar o trace");
+            for(int i = 0; i < 2 * usesCapacity; i++) uses[i].process = -1;
+            for(int i = 0; i < usesCapacity; i++){
+                if(old[i].process != -1) *findTraceUse(uses, 2 * usesCapacity, old[i].process, old[i].page) = old[i];
+            }
+            usesCapacity *= 2;
+            free(old);
+        }
+
+        TraceUse *use = findTraceUse(uses, usesCapacity, reference.process, reference.page);
+        if(use->process == -1){
+            use->process = reference.process;
+            use->page = reference.page;
+            numUses++;
+        }else{
+            traceNextUses[use->position] = references;
+        }
+        use->position = references;
+        traceNextUses[references++] = NO_NEXT_USE;
+    }
+    free(uses);
+}
+
+/**
+ * @brief Proxima referencia do trace na ordem do arquivo
+ *
+ * @param reference Referencia lida
+ * @return int 0 no fim do trace
+ */
+int nextTraceReference(TraceReference *reference){
+    if(!decodeReference(&mainCursor, reference)) return 0;
+
+    releaseTrace(&mainCursor);
+    currentReference = *reference;
+    currentPosition++;
+    return 1;
+}
+
+/**
+ * @brief Pagina virtual da referencia que esta sendo simulada
+ */
+long long currentTracePage(){
+    return currentReference.page;
+}
+
+/**
+ * @brief Posicao no trace do proximo uso da pagina da referencia que esta sendo simulada
+ *
+ * @return long long Posicao ou NO_NEXT_USE se a pagina nao e usada de novo pelo processo
+ */
+long long nextTraceUse(){
+    return traceNextUses[currentPosition];
+}
@@ -0,0 +1,170 @@
+#include "../headers/replacement.h"
+#include <string.h>
+
+typedef struct WorkingSetState WorkingSetState;
+
+/*
+ * Modelo de working set de Denning: o working set sao as paginas referenciadas nas ultimas
+ * WORKING_SET_WINDOW referencias do processo (tempo virtual). Cada pagina tem um registrador de
+ * envelhecimento de WS_AGING_BITS bits, guardado transposto em bitmaps (o plano k tem o bit k de
+ * todas as paginas), entao o deslocamento de todos os registradores a cada tique e feito 64 paginas
+ * por vez. Paginas residentes cujo registrador zera sairam da janela e sao liberadas
+ */
+struct WorkingSetState{
+    int words; // palavras de 64 bits de cada bitmap
+    unsigned long long *resident;
+    unsigned long long *referenced; // referenciadas no tique atual
+    unsigned long long *planes[WS_AGING_BITS];
+    int newestPlane;
+    unsigned long long *expired; // residentes fora da janela, esperando serem liberadas
+    int expiredCursor;
+    unsigned long long *candidates;
+
+    long long virtualTime;
+    int tickLength; // referencias do processo por tique
+};
+
+void* createWorkingSetState(Process *process);
+unsigned long long* createBitmap(int words);
+void workingSetTick(WorkingSetState *ws);
+void workingSetReference(WorkingSetState *ws, int page);
+void workingSetHit(void *state, int page);
+void workingSetMiss(void *state, int page);
+int workingSetVictim(void *state, int incomingPage);
+int workingSetExpired(void *state);
+int workingSetSize(Process *process);
+
+ReplacementPolicy workingSetPolicy = {"WS", createWorkingSetState, workingSetHit, workingSetMiss, workingSetVictim, NULL, workingSetExpired};
+
+unsigned long long* createBitmap(int words){
+    unsigned long long *bitmap = (unsigned long long *)calloc(words, sizeof(unsigned long long));
+    if(bitmap == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+    return bitmap;
+}
+
+void* createWorkingSetState(Process *process){
+    WorkingSetState *ws = (WorkingSetState *)malloc(sizeof(WorkingSetState));
+    if(ws == NULL){
+        exit(PROCESS_CREATION_ERROR);
+    }
+
+    ws->words = (NUM_PAGES + 63) / 64;
+    ws->resident = createBitmap(ws->words);
+    ws->referenced = createBitmap(ws->words);
+    for(int i = 0; i < WS_AGING_BITS; i++) ws->planes[i] = createBitmap(ws->words);
+    ws->newestPlane = 0;
+    ws->expired = createBitmap(ws->words);
+    ws->expiredCursor = 0;
+    ws->candidates = createBitmap(ws->words);
+
+    ws->virtualTime = 0;
+    ws->tickLength = (WORKING_SET_WINDOW + WS_AGING_BITS - 1) / WS_AGING_BITS;
+    return ws;
+}
+
+/**
+ * @brief Desloca todos os registradores de envelhecimento: o plano mais antigo e descartado e da lugar
+ * aos bits de referencia do tique que terminou. As paginas residentes sem nenhum bit sairam da janela
+ */
+void workingSetTick(WorkingSetState *ws){
+    ws->newestPlane = (ws->newestPlane + 1) % WS_AGING_BITS;
+    unsigned long long *newest = ws->planes[ws->newestPlane];
+
+    for(int w = 0; w < ws->words; w++){
+        newest[w] = ws->referenced[w];
+        ws->referenced[w] = 0;
+
+        unsigned long long window = 0;
+        for(int i = 0; i < WS_AGING_BITS; i++) window |= ws->planes[i][w];
+        ws->expired[w] = ws->resident[w] & ~window;
+    }
+    ws->expiredCursor = 0;
+}
+
+void workingSetReference(WorkingSetState *ws, int page){
+    ws->referenced[page / 64] |= 1ULL << (page % 64);
+    if(++ws->virtualTime % ws->tickLength == 0) workingSetTick(ws);
+}
+
+void workingSetHit(void *state, int page){
+    workingSetReference((WorkingSetState *)state, page);
+}
+
+void workingSetMiss(void *state, int page){
+    WorkingSetState *ws = (WorkingSetState *)state;
+    ws->resident[page / 64] |= 1ULL << (page % 64);
+    workingSetReference(ws, page);
+}
+
+/**
+ * @brief Vitima com o menor registrador de envelhecimento (usada quando o processo e retirado da memoria):
+ * filtra os candidatos plano a plano, do mais recente para o mais antigo, mantendo os que tem o bit zerado
+ */
+int workingSetVictim(void *state, int incomingPage){
+    WorkingSetState *ws = (WorkingSetState *)state;
+
+    unsigned long long any = 0;
+    for(int w = 0; w < ws->words; w++){
+        ws->candidates[w] = ws->resident[w] & ~ws->referenced[w];
+        any |= ws->candidates[w];
+    }
+    if(!any) memcpy(ws->candidates, ws->resident, sizeof(unsigned long long) * ws->words);
+
+    for(int i = 0; i < WS_AGING_BITS; i++){
+        unsigned long long *plane = ws->planes[(ws->newestPlane - i + WS_AGING_BITS) % WS_AGING_BITS];
+
+        any = 0;
+        for(int w = 0; w < ws->words; w++) any |= ws->candidates[w] & ~plane[w];
+        if(!any) continue;
+        for(int w = 0; w < ws->words; w++) ws->candidates[w] &= ~plane[w];
+    }
+
+    int w = 0;
+    while(!ws->candidates[w]) w++;
+    int page = w * 64 + __builtin_ctzll(ws->candidates[w]);
+
+    unsigned long long mask = ~(1ULL << (page % 64));
+    ws->resident[w] &= mask;
+    ws->expired[w] &= mask;
+    return page;
+}
+
+/**
+ * @brief Proxima pagina residente que saiu da janela, retirando-a do working set
+ *
+ * @return int Pagina ou -1 se nenhuma
+ */
+int workingSetExpired(void *state){
+    WorkingSetState *ws = (WorkingSetState *)state;
+
+    for(; ws->expiredCursor < ws->words; ws->expiredCursor++){
+        unsigned long long word = ws->expired[ws->expiredCursor];
+        if(!word) continue;
+
+        unsigned long long bit = word & -word;
+        ws->expired[ws->expiredCursor] &= ~bit;
+        ws->resident[ws->expiredCursor] &= ~bit;
+        return ws->expiredCursor * 64 + __builtin_ctzll(bit);
+    }
+    return -1;
+}
+
+/**
+ * @brief Tamanho do working set do processo: paginas referenciadas dentro da janela
+ *
+ * @param process Processo
+ * @return int Quantidade de paginas
+ */
+int workingSetSize(Process *process){
+    WorkingSetState *ws = (WorkingSetState *)process->workingSet->policyState;
+
+    int size = 0;
+    for(int w = 0; w < ws->words; w++){
+        unsigned long long window = ws->referenced[w];
+        for(int i = 0; i < WS_AGING_BITS; i++) window |= ws->planes[i][w];
+        size += __builtin_popcountll(window);
+    }
+    return size;
+}
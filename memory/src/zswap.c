@@ -0,0 +1,119 @@
+#include "../headers/zswap.h"
+#include "../headers/swap.h"
+#include <math.h>
+
+ZswapPool *zswapPool = NULL;
+ZswapStatistics zswapStatistics;
+
+void createZswapPool(RAM *ram);
+PageElement** compressedNodesOf(int pid);
+int compressedSize(int pid, int pageNumber);
+void spillCompressedPage();
+int storeCompressedPage(int pid, int pageNumber);
+int loadCompressedPage(int pid, int pageNumber);
+void printZswapStatistics();
+
+/**
+ * @brief Reserva os frames do pool na memoria principal
+ *
+ * @param ram Memoria principal
+ */
+void createZswapPool(RAM *ram){
+    zswapPool = (ZswapPool *)calloc(1, sizeof(ZswapPool));
+    if(zswapPool == NULL){
+        exit(RAM_CREATION_ERROR);
+    }
+
+    zswapPool->frames = (long long)FRAMES * ZSWAP_PERCENT / 100;
+    if(zswapPool->frames < 1) exitProgram(INVALID_NUMBER, "O pool comprimido nao tem nenhum frame, aumente -Z ou -f");
+    for(int i = 0; i < zswapPool->frames; i++) addPageToRAM(ram);
+
+    zswapPool->capacity = (long long)zswapPool->frames * VIRTUAL_PAGE_SIZE;
+    initPageList(&zswapPool->lru);
+}
+
+PageElement** compressedNodesOf(int pid){
+    if(!zswapPool->nodes[pid]) zswapPool->nodes[pid] = createNodeIndex();
+    return zswapPool->nodes[pid];
+}
+
+/**
+ * @brief Tamanho comprimido da pagina, sorteado de forma deterministica pela pagina: ZSWAP_INCOMPRESSIBLE
+ * por cento das paginas nao comprimem e as demais tem razao log-uniforme entre ZSWAP_RATIO/sqrt(2) e ZSWAP_RATIO*sqrt(2)
+ *
+ * @param pid Processo
+ * @param pageNumber Pagina
+ * @return int Tamanho em bytes
+ */
+int compressedSize(int pid, int pageNumber){
+    unsigned long long x = generatorSeed() ^ ((unsigned long long)pid << 32 | (unsigned int)pageNumber);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+
+    double u = (x >> 11) * 0x1.0p-53;
+    double incompressible = ZSWAP_INCOMPRESSIBLE / 100.0;
+    if(u < incompressible) return VIRTUAL_PAGE_SIZE;
+
+    double ratio = ZSWAP_RATIO / 10.0 * exp2((u - incompressible) / (1 - incompressible) - 0.5);
+    int size = (int)(VIRTUAL_PAGE_SIZE / ratio);
+    return size > 0 ? size : 1;
+}
+
+/**
+ * @brief Grava no swap a pagina mais antiga do pool
+ */
+void spillCompressedPage(){
+    PageElement *oldest = zswapPool->lru.head;
+    int pid = oldest->list;
+    int pageNumber = oldest->pageNumber;
+
+    dropPage(&zswapPool->lru, compressedNodesOf(pid), pageNumber);
+    zswapPool->used -= compressedSize(pid, pageNumber);
+    zswapStatistics.spills++;
+    writeSwapPage(pid, pageNumber);
+}
+
+/**
+ * @brief Guarda a pagina suja retirada da memoria no pool, abrindo espaco com as mais antigas
+ *
+ * @param pid Processo
+ * @param pageNumber Pagina
+ * @return int 1 se guardada, 0 se incompressivel
+ */
+int storeCompressedPage(int pid, int pageNumber){
+    int size = compressedSize(pid, pageNumber);
+    if(size >= VIRTUAL_PAGE_SIZE || size > zswapPool->capacity){
+        zswapStatistics.rejects++;
+        return 0;
+    }
+
+    while(zswapPool->used + size > zswapPool->capacity) spillCompressedPage();
+    pushPage(&zswapPool->lru, compressedNodesOf(pid), pageNumber, pid);
+    zswapPool->used += size;
+    zswapStatistics.stores++;
+    zswapStatistics.storedBytes += size;
+    return 1;
+}
+
+/**
+ * @brief Retira a pagina do pool na falta
+ *
+ * @param pid Processo
+ * @param pageNumber Pagina
+ * @return int 1 se a pagina estava no pool
+ */
+int loadCompressedPage(int pid, int pageNumber){
+    PageElement **nodes = compressedNodesOf(pid);
+    if(!nodes[pageNumber]) return 0;
+
+    dropPage(&zswapPool->lru, nodes, pageNumber);
+    zswapPool->used -= compressedSize(pid, pageNumber);
+    zswapStatistics.loads++;
+    return 1;
+}
+
+void printZswapStatistics(){
+    printf("-> Zswap: %d frames (%.1f KB), %d paginas ocupando %.1f KB (%.1f%%), razao media %.2f\n", zswapPool->frames, zswapPool->capacity / 1024.0, zswapPool->lru.size, zswapPool->used / 1024.0, 100.0 * zswapPool->used / zswapPool->capacity, zswapStatistics.storedBytes ? (double)zswapStatistics.stores * VIRTUAL_PAGE_SIZE / zswapStatistics.storedBytes : 0);
+    printf("-> Zswap: %lld paginas guardadas, %lld incompressiveis, %lld lidas de volta, %lld gravadas no swap pelo LRU do pool\n", zswapStatistics.stores, zswapStatistics.rejects, zswapStatistics.loads, zswapStatistics.spills);
+}
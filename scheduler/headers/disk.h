@@ -0,0 +1,22 @@
+#ifndef __DISK_H__
+#define __DISK_H__
+
+#include "globals.h"
+#include "structures.h"
+
+// Geometria do disco simulado
+#define DISK_CYLINDERS 200
+#define BLOCKS_PER_CYLINDER 8
+#define DISK_BLOCKS (DISK_CYLINDERS * BLOCKS_PER_CYLINDER)
+
+// Politicas de escalonamento da fila do disco
+#define DISK_FIFO 0
+#define DISK_SSTF 1
+#define DISK_SCAN 2
+#define DISK_CLOOK 3
+
+extern void checkDiskStart(StructureCollection *structures);
+extern void checkDiskEnd(StructureCollection *structures, ProcessQueueDescriptor *returnQueue, int instant);
+extern char* diskPolicyName(int policy);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef __FAIRSHARE_H__
+#define __FAIRSHARE_H__
+
+#include "globals.h"
+#include "structures.h"
+
+// Escala do tempo virtual, para que pesos diferentes tenham precisao inteira
+#define VIRTUAL_TIME_SCALE 1024
+#define DEFAULT_GROUP_WEIGHT 1
+#define MAX_GROUPS 64
+
+extern GroupScheduler* createGroupScheduler(Process *processes, int numProcesses);
+extern void destroyGroupScheduler(GroupScheduler **groups);
+extern void addGroupQueue(GroupScheduler *groups, Process *process, int priority, int front);
+extern void checkGroupStart(StructureCollection *structures, int instant);
+extern void chargeGroup(StructureCollection *structures, Device *cpu, Group *group, int instant);
+extern void refreshGroupQuotas(GroupScheduler *groups, int instant);
+extern void printGroupStatistics(GroupScheduler *groups, int instants);
+
+#endif
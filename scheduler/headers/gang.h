@@ -0,0 +1,9 @@
+#ifndef __GANG_H__
+#define __GANG_H__
+
+#include "globals.h"
+#include "structures.h"
+
+extern void checkGangStart(StructureCollection *structures, int instant);
+
+#endif
@@ -11,12 +11,29 @@
 #define HELP_TEXT \
 "Simula o funcionamento de um escalonador de processos com escalonamento circular\n\
 Para executar rode:\n\
-\t scheduler [-q#] [-d#] [-t#] [-p#]\n\
+\t scheduler [-q#] [-d#] [-t#] [-p#] [-e#] [-s#] [-r#] [-m#] [-c#] [-w#] [-k#] [-f###] [-a#] [-j#] [-x#] [-u#] [-g#] [-o#] [-n#] [-l#] [-b#]\n\
 \n\
 \tq\t: Tamanho do quantum (Time slice)\n\
-\td\t: Tempo de leitura do disco\n\
+\td\t: Tempo de leitura do disco (transferencia de um bloco)\n\
 \tt\t: Tempo de leitura da fita magnetica\n\
 \tp\t: Tempo de leitura da impressora\n\
+\te\t: Politica da fila do disco (0 FIFO, 1 SSTF, 2 SCAN, 3 C-LOOK)\n\
+\ts\t: Cilindros percorridos por unidade de tempo no seek (0 desativa o custo de seek)\n\
+\tr\t: Tempo de uma rotacao do disco (latencia media de meia rotacao)\n\
+\tm\t: Junta requisicoes de blocos adjacentes (0 desativado, 1 ativado)\n\
+\tc\t: Custo da troca de contexto na CPU\n\
+\tw\t: Penalidade maxima de cache frio ao voltar para a CPU\n\
+\tk\t: Meia-vida do calor da cache (o calor cai pela metade a cada k ut sem executar)\n\
+\tf\t: Fila de retorno de disco, fita e impressora (ex.: 100, 0 alta e 1 baixa prioridade)\n\
+\ta\t: Ajuste automatico de quantum e retorno (1 tempo de resposta medio, 2 turnaround p99, 3 throughput)\n\
+\tj\t: Quantidade de simulacoes paralelas no ajuste automatico\n\
+\tx\t: Maior quantum avaliado no ajuste automatico\n\
+\tu\t: Utilizacao maxima (%) admitida na classe de tempo real (EDF); ativa deadlines nos processos aleatorios e do teclado\n\
+\tg\t: Compartilhamento justo por grupo de processos (0 desativado, 1 ativado)\n\
+\to\t: Periodo das cotas de CPU dos grupos\n\
+\tn\t: Quantidade de CPUs\n\
+\tl\t: Coescalonamento de threads (0 gangue estrita, 1 coescalonamento relaxado)\n\
+\tb\t: Executa tarefas reais com # ms por ut e compara com a simulacao (0 desativado)\n\
 "
 
 // Status do processo
@@ -33,6 +50,7 @@ Para executar rode:\n\
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
 extern void exitProgram(int error, char *errorMessage);
 extern int readNumber(long *number);
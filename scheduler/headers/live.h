@@ -0,0 +1,63 @@
+#ifndef __LIVE_H__
+#define __LIVE_H__
+
+#include <pthread.h>
+#include <ucontext.h>
+#include "globals.h"
+#include "structures.h"
+#include "scheduler.h"
+
+// Tamanho da pilha de cada tarefa real
+#define LIVE_STACK_SIZE (64 * 1024)
+
+typedef struct LiveTask LiveTask;
+typedef struct LiveWorker LiveWorker;
+typedef struct LiveDevice LiveDevice;
+typedef struct LiveExecutor LiveExecutor;
+
+// Tarefa de nivel de usuario que executa o trabalho de CPU de um processo
+struct LiveTask{
+    ucontext_t context;
+    ucontext_t *returnContext; // contexto do worker que esta executando a tarefa
+    char *stack;
+    Process *process;
+
+    int simulatedTurnaround;
+    int simulatedResponse;
+    double arrival; // instantes reais em ms desde o inicio da execucao
+    double firstRun;
+    double finish;
+};
+
+// Thread que faz o papel de uma CPU
+struct LiveWorker{
+    pthread_t thread;
+    ucontext_t context;
+    LiveExecutor *executor;
+};
+
+// Thread que atende a fila de um dispositivo de IO dormindo pelo tempo da operacao
+struct LiveDevice{
+    pthread_t thread;
+    Device *device;
+    ProcessQueueDescriptor *queue;
+    int returnPriority;
+    LiveExecutor *executor;
+};
+
+struct LiveExecutor{
+    StructureCollection *structures;
+    LiveTask *tasks;
+    LiveWorker workers[MAX_CPUS];
+    LiveDevice devices[3];
+
+    pthread_mutex_t lock; // protege as filas e os processos fora das CPUs
+    pthread_cond_t changed;
+    struct timespec start;
+    int finishedProcesses;
+    int stop;
+};
+
+extern void liveExecute(StructureCollection *structures);
+
+#endif
@@ -6,5 +6,7 @@
 #include "scheduler_arguments.h"
 #include "processes_input.h"
 #include "scheduler.h"
+#include "tuner.h"
+#include "live.h"
 
 #endif
@@ -0,0 +1,12 @@
+#ifndef __REALTIME_H__
+#define __REALTIME_H__
+
+#include "globals.h"
+#include "structures.h"
+
+extern void addRealTimeProcess(StructureCollection *structures, Process *process, ProcessQueueDescriptor *fallbackQueue);
+extern void checkRealTimeStart(StructureCollection *structures, int instant);
+extern void finishRealTimeProcess(StructureCollection *structures, Process *process);
+extern double processUtilization(Process *process);
+
+#endif
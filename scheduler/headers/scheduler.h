@@ -3,7 +3,13 @@
 
 #include "globals.h"
 #include "structures.h"
+#include "disk.h"
+#include "realtime.h"
+#include "fairshare.h"
+#include "gang.h"
 
 extern void scheduler(StructureCollection *structures);
+extern void dispatchCPU(Device *cpu, Process *process, Statistics *statistics, int instant);
+extern void releaseCPUs(DeviceCollection *devices, Process *process);
 
 #endif
@@ -6,15 +6,68 @@
 // Constantes com definicoes de tempos e limites
 #define MAX_PROCESSES 5
 #define MAX_IO 3
+#define MAX_CPUS 16
 #define TIME_SLICE getTimeSlice()
 #define DISK_TIMER getDiskTimer()
 #define TAPE_TIMER getTapeTimer()
 #define PRINTER_TIME getPrinterTimer()
+#define DISK_POLICY getDiskPolicy()
+#define DISK_SEEK_RATE getDiskSeekRate()
+#define DISK_ROTATION getDiskRotation()
+#define DISK_MERGE getDiskMerge()
+#define CONTEXT_SWITCH_COST getContextSwitchCost()
+#define CACHE_PENALTY getCachePenalty()
+#define CACHE_HALF_LIFE getCacheHalfLife()
+#define DISK_RETURN getDiskReturn()
+#define TAPE_RETURN getTapeReturn()
+#define PRINTER_RETURN getPrinterReturn()
+#define TUNE_OBJECTIVE getTuneObjective()
+#define TUNE_WORKERS getTuneWorkers()
+#define TUNE_MAX_QUANTUM getTuneMaxQuantum()
+#define RT_UTILIZATION_BOUND getRealTimeUtilizationBound()
+#define REAL_TIME_CLASS getRealTimeClass()
+#define FAIR_SHARE getFairShare()
+#define QUOTA_PERIOD getQuotaPeriod()
+#define NUM_CPUS getNumCpus()
+#define COSCHEDULING getCoscheduling()
+#define LIVE_TIME_UNIT getLiveTimeUnit()
+
+// Modos de coescalonamento de processos com varias threads
+#define STRICT_GANG 0
+#define RELAXED_COSCHEDULING 1
+
+// Objetivos do modo de ajuste automatico
+#define TUNE_DISABLED 0
+#define TUNE_MEAN_RESPONSE 1
+#define TUNE_P99_TURNAROUND 2
+#define TUNE_THROUGHPUT 3
 
 extern int getTimeSlice();
 extern int getDiskTimer();
 extern int getTapeTimer();
 extern int getPrinterTimer();
+extern int getDiskPolicy();
+extern int getDiskSeekRate();
+extern int getDiskRotation();
+extern int getDiskMerge();
+extern int getContextSwitchCost();
+extern int getCachePenalty();
+extern int getCacheHalfLife();
+extern int getDiskReturn();
+extern int getTapeReturn();
+extern int getPrinterReturn();
+extern int getTuneObjective();
+extern int getTuneWorkers();
+extern int getTuneMaxQuantum();
+extern int getRealTimeUtilizationBound();
+extern int getRealTimeClass();
+extern int getFairShare();
+extern int getQuotaPeriod();
+extern int getNumCpus();
+extern int getCoscheduling();
+extern int getLiveTimeUnit();
+extern void setTimeSlice(int value);
+extern void setFeedbackRouting(int routing);
 extern void readArgumentsFromConsole(int argc, char *argv[]);
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef __STATISTICS_H__
+#define __STATISTICS_H__
+
+#include "globals.h"
+
+typedef struct SampleSet SampleSet;
+
+// Conjunto de amostras para calculo de distribuicoes (latencia, turnaround, ...)
+struct SampleSet{
+    int *values;
+    int size;
+    int capacity;
+    int sorted;
+};
+
+extern SampleSet* createSampleSet();
+extern void addSample(SampleSet *set, int value);
+extern double meanSample(SampleSet *set);
+extern int percentileSample(SampleSet *set, double percentile);
+extern void printSampleSet(char *name, SampleSet *set);
+extern void destroySampleSet(SampleSet **set);
+
+#endif
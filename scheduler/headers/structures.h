@@ -3,6 +3,7 @@
 
 #include "globals.h"
 #include "scheduler_arguments.h"
+#include "statistics.h"
 
 typedef struct Process Process;
 typedef struct Device Device;
@@ -12,10 +13,16 @@ typedef struct IOElement IOElement;
 typedef struct QueueCollection QueueCollection;
 typedef struct DeviceCollection DeviceCollection;
 typedef struct StructureCollection StructureCollection;
+typedef struct DiskState DiskState;
+typedef struct Statistics Statistics;
+typedef struct DeadlineHeap DeadlineHeap;
+typedef struct Group Group;
+typedef struct GroupHeap GroupHeap;
+typedef struct GroupScheduler GroupScheduler;
 
 struct Process{
     int pid;
-    int ppid;
+    int ppid; // tambem usado como id do grupo no compartilhamento justo
     int status;
     int priority;
 
@@ -23,9 +30,27 @@ struct Process{
     int processedTime;
     int serviceTime;
 
+    int finishTime;
+    int firstRunTime; // primeiro instante em que executou na CPU (-1 se nunca executou)
+    int lastRunTime; // ultimo instante em que executou na CPU (-1 se nunca executou)
+
     int actualIO;
     int numIO;
     IOElement *IO;
+
+    int deadline; // deadline relativo ao tempo de chegada (0 se nao for tempo real)
+    int period; // periodo minimo entre chegadas, usado na admissao (0 usa o deadline)
+    int absoluteDeadline;
+    int realTime; // 1 se foi admitido na classe de tempo real
+
+    Group *group; // grupo do compartilhamento justo (NULL se desativado)
+
+    int threads; // quantidade de threads (o tempo de servico e por thread)
+    int runningThreads; // quantidade de CPUs ocupadas pelo processo
+    int threadProgress; // ut de thread acumuladas ate completar uma ut do processo
+
+    int ioBlock; // bloco alvo da requisicao de disco pendente
+    int ioRequestTime; // instante em que a requisicao de IO entrou na fila
 };
 
 struct Device{
@@ -33,6 +58,10 @@ struct Device{
     int remainingTime;
     int duration;
     char name[16];
+
+    int overheadTime; // tempo restante de troca de contexto antes de executar o processo
+    int cacheOverheadTime; // parte de overheadTime que e de cache fria, cobrada depois da troca
+    Process *lastProcess; // ultimo processo que executou no dispositivo
 };
 
 struct ProcessQueueElement{
@@ -49,9 +78,60 @@ struct IOElement{
     ProcessQueueDescriptor *deviceQueue;
     char* type; // descritor somente por necessidades de output no console
     int initialTime;
+    int block; // bloco alvo (somente para disco)
+};
+
+// Heap de minimo por deadline absoluto da classe de tempo real (EDF)
+struct DeadlineHeap{
+    Process **processes;
+    int size;
+    int capacity;
+    double utilization; // utilizacao dos processos admitidos e ainda nao finalizados
+};
+
+// Heap de minimo por tempo virtual com os grupos de um nivel que possuem processos prontos e nao estao limitados
+struct GroupHeap{
+    Group **heap;
+    int size;
+    long minVirtualTime;
+};
+
+// Grupo de processos (como um cgroup) com peso e cota de CPU por periodo, dentro de um grupo pai ou na raiz
+struct Group{
+    int id;
+    int parentId; // -1 na raiz
+    int weight;
+    int quota; // ut de CPU por periodo (0 sem cota)
+
+    long virtualTime; // tempo de CPU ponderado pelo peso
+    int usedInPeriod;
+    int throttled;
+    int throttleStart;
+    int heapIndex; // posicao no heap do nivel (-1 se nao estiver no heap)
+
+    int cpuTime; // inclui o tempo dos subgrupos
+    int throttleEvents;
+    int throttledTime;
+
+    Group *parent; // NULL na raiz
+    GroupHeap *level; // heap em que o grupo disputa a CPU: o dos subgrupos do pai ou o da raiz
+    GroupHeap children; // subgrupos prontos
+    int numChildren;
+
+    // Processos prontos, so em grupos sem subgrupos
+    ProcessQueueDescriptor *highPriority;
+    ProcessQueueDescriptor *lowPriority;
+};
+
+struct GroupScheduler{
+    Group *groups;
+    int numGroups;
+    GroupHeap root;
 };
 
 struct QueueCollection {
+    DeadlineHeap *realTime;
+    GroupScheduler *groups; // NULL se o compartilhamento justo estiver desativado
     ProcessQueueDescriptor *highPriority;
     ProcessQueueDescriptor *lowPriority;
     ProcessQueueDescriptor *diskQueue;
@@ -60,10 +140,43 @@ struct QueueCollection {
 };
 
 struct DeviceCollection {
-    Device *cpu;
+    Device *cpu; // primeira CPU
+    Device *cpus[MAX_CPUS];
+    int numCpus;
+
     Device *disk;
     Device *tape;
     Device *printer;
+
+    DiskState *diskState;
+};
+
+struct DiskState{
+    int cylinder; // posicao atual do cabecote
+    int direction; // 1 subindo, -1 descendo (SCAN)
+    ProcessQueueDescriptor *merged; // requisicoes adjacentes atendidas junto com a atual
+};
+
+struct Statistics{
+    int instants;
+    int diskRequests;
+    int diskBusyTime;
+    int cpuBusyTime;
+    int contextSwitches;
+    int switchOverhead;
+    int cacheOverhead;
+    int fragmentedCpuTime; // CPU ociosa com processos prontos que nao couberam
+    int idleCpuTime; // CPU ociosa sem processos prontos
+    int partialDispatches; // processos colocados com menos CPUs que threads
+    SampleSet *diskLatency;
+    SampleSet *turnaround;
+    SampleSet *response;
+
+    int deadlineProcesses;
+    int admittedProcesses;
+    int deadlineMisses;
+    int preemptions;
+    SampleSet *lateness;
 };
 
 struct StructureCollection{
@@ -73,13 +186,24 @@ struct StructureCollection{
     int actualProcessIndex;
     int numProcesses;
     Process *processes;
+
+    Statistics *statistics;
 };
 
 #include "processes_input.h"
 
 
+extern ProcessQueueDescriptor* createQueue();
 extern void addQueue(ProcessQueueDescriptor *queue, Process *process);
 extern Process* removeQueue(ProcessQueueDescriptor *queue);
+extern Process* removeQueueAfter(ProcessQueueDescriptor *queue, ProcessQueueElement *previous);
+extern void addQueueFront(ProcessQueueDescriptor *queue, Process *process);
+extern void pushDeadline(DeadlineHeap *heap, Process *process);
+extern Process* popDeadline(DeadlineHeap *heap);
+extern Process* peekDeadline(DeadlineHeap *heap);
+extern void returnProcess(QueueCollection *queues, ProcessQueueDescriptor *queue, Process *process);
+extern void returnProcessFront(QueueCollection *queues, Process *process);
+extern ProcessQueueDescriptor* feedbackQueue(QueueCollection *queues, int priority);
 extern StructureCollection* createStructures(int readProcessesFrom);
 extern void destroyStructures(StructureCollection **collection);
 
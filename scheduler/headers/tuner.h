@@ -0,0 +1,26 @@
+#ifndef __TUNER_H__
+#define __TUNER_H__
+
+#include "globals.h"
+#include "structures.h"
+#include "scheduler.h"
+
+// Quantidade de combinacoes de retorno (alta ou baixa prioridade para disco, fita e impressora)
+#define ROUTINGS 8
+
+typedef struct TuningResult TuningResult;
+
+// Metricas de uma configuracao avaliada
+struct TuningResult{
+    int quantum;
+    int routing;
+    int valid;
+
+    double meanResponse;
+    int p99Turnaround;
+    double throughput;
+};
+
+extern void autoTune(StructureCollection *structures);
+
+#endif
@@ -0,0 +1,177 @@
+#include "../headers/disk.h"
+
+void checkDiskStart(StructureCollection *structures);
+void checkDiskEnd(StructureCollection *structures, ProcessQueueDescriptor *returnQueue, int instant);
+char* diskPolicyName(int policy);
+int blockCylinder(int block);
+ProcessQueueElement* selectDiskRequest(ProcessQueueDescriptor *queue, DiskState *state, int *seekDistance);
+int mergeAdjacentRequests(ProcessQueueDescriptor *queue, DiskState *state, int *lowBlock, int *highBlock);
+int diskServiceTime(int seekDistance, int blocks);
+
+/*
+ * Nome da politica de escalonamento do disco
+ */
+char* diskPolicyName(int policy){
+    switch(policy){
+        case DISK_SSTF:
+            return "SSTF";
+        case DISK_SCAN:
+            return "SCAN";
+        case DISK_CLOOK:
+            return "C-LOOK";
+    }
+    return "FIFO";
+}
+
+/*
+ * Cilindro onde esta o bloco
+ */
+int blockCylinder(int block){
+    return block / BLOCKS_PER_CYLINDER;
+}
+
+/*
+ * Escolhe a proxima requisicao da fila do disco de acordo com a politica.
+ * Retorna o elemento anterior ao escolhido (NULL se for a cabeca) e a distancia de seek percorrida
+ */
+ProcessQueueElement* selectDiskRequest(ProcessQueueDescriptor *queue, DiskState *state, int *seekDistance){
+    ProcessQueueElement *previous = NULL, *best = NULL, *bestPrevious = NULL;
+    int bestDistance = -1;
+
+    if(DISK_POLICY == DISK_FIFO){
+        *seekDistance = abs(blockCylinder(queue->head->process->ioBlock) - state->cylinder);
+        return NULL;
+    }
+
+    // Primeira passada: SSTF olha todos, SCAN olha na direcao atual e C-LOOK somente para cima
+    int direction = DISK_POLICY == DISK_CLOOK ? 1 : state->direction;
+    for(ProcessQueueElement *element = queue->head; element; previous = element, element = element->next){
+        int delta = blockCylinder(element->process->ioBlock) - state->cylinder;
+        if(DISK_POLICY != DISK_SSTF && delta * direction < 0) continue;
+
+        if(bestDistance == -1 || abs(delta) < bestDistance){
+            best = element;
+            bestPrevious = previous;
+            bestDistance = abs(delta);
+        }
+    }
+    if(best){
+        *seekDistance = bestDistance;
+        return bestPrevious;
+    }
+
+    // Nenhuma requisicao a frente do cabecote
+    previous = NULL;
+    if(DISK_POLICY == DISK_SCAN){
+        // O cabecote vai ate a borda do disco e volta na direcao oposta
+        int edge = state->direction == 1 ? DISK_CYLINDERS - 1 : 0;
+        state->direction = -state->direction;
+        for(ProcessQueueElement *element = queue->head; element; previous = element, element = element->next){
+            int distance = abs(edge - blockCylinder(element->process->ioBlock));
+            if(bestDistance == -1 || distance < bestDistance){
+                bestPrevious = previous;
+                bestDistance = distance;
+            }
+        }
+        *seekDistance = abs(edge - state->cylinder) + bestDistance;
+        return bestPrevious;
+    }
+
+    // C-LOOK: retorna para a requisicao de menor cilindro
+    int lowest = -1;
+    for(ProcessQueueElement *element = queue->head; element; previous = element, element = element->next){
+        int cylinder = blockCylinder(element->process->ioBlock);
+        if(lowest == -1 || cylinder < lowest){
+            bestPrevious = previous;
+            lowest = cylinder;
+        }
+    }
+    *seekDistance = state->cylinder - lowest;
+    return bestPrevious;
+}
+
+/*
+ * Junta a requisicao atual com as requisicoes da fila para blocos iguais ou adjacentes.
+ * Retorna quantas requisicoes foram juntadas
+ */
+int mergeAdjacentRequests(ProcessQueueDescriptor *queue, DiskState *state, int *lowBlock, int *highBlock){
+    int mergedRequests = 0;
+    int changed = 1;
+
+    while(changed){
+        changed = 0;
+        ProcessQueueElement *previous = NULL;
+        for(ProcessQueueElement *element = queue->head; element; previous = element, element = element->next){
+            int block = element->process->ioBlock;
+            if(block < *lowBlock - 1 || block > *highBlock + 1) continue;
+
+            if(block < *lowBlock) *lowBlock = block;
+            if(block > *highBlock) *highBlock = block;
+            addQueue(state->merged, removeQueueAfter(queue, previous));
+            mergedRequests++;
+            changed = 1;
+            break;
+        }
+    }
+    return mergedRequests;
+}
+
+/*
+ * Tempo de servico: seek + meia rotacao + transferencia dos blocos
+ */
+int diskServiceTime(int seekDistance, int blocks){
+    int seekTime = 0;
+    if(DISK_SEEK_RATE && seekDistance) seekTime = 1 + seekDistance / DISK_SEEK_RATE;
+
+    int serviceTime = seekTime + DISK_ROTATION / 2 + DISK_TIMER * blocks;
+    return serviceTime > 0 ? serviceTime : 1;
+}
+
+/*
+ * Verifica se ha uma requisicao para entrada no disco
+ */
+void checkDiskStart(StructureCollection *structures){
+    Device *disk = structures->devices->disk;
+    DiskState *state = structures->devices->diskState;
+    ProcessQueueDescriptor *queue = structures->queues->diskQueue;
+    if(disk->actualProcess) return;
+
+    disk->remainingTime = disk->duration;
+    if(!queue->head) return;
+
+    int seekDistance;
+    ProcessQueueElement *previous = selectDiskRequest(queue, state, &seekDistance);
+    disk->actualProcess = removeQueueAfter(queue, previous);
+
+    int lowBlock = disk->actualProcess->ioBlock, highBlock = lowBlock;
+    int mergedRequests = DISK_MERGE ? mergeAdjacentRequests(queue, state, &lowBlock, &highBlock) : 0;
+
+    disk->remainingTime = diskServiceTime(seekDistance, highBlock - lowBlock + 1);
+    state->cylinder = blockCylinder(state->direction == 1 ? highBlock : lowBlock);
+
+    printf("+ Processo %d entrou no dispositivo %s (bloco %d, seek de %d cilindro(s), %d ut)\n", disk->actualProcess->pid, disk->name, disk->actualProcess->ioBlock, seekDistance, disk->remainingTime);
+    if(mergedRequests) printf("+ %d requisicao(oes) adjacente(s) juntada(s) a do processo %d\n", mergedRequests, disk->actualProcess->pid);
+}
+
+/*
+ * Verifica se a requisicao do disco chegou ao fim, devolvendo todos os processos atendidos
+ */
+void checkDiskEnd(StructureCollection *structures, ProcessQueueDescriptor *returnQueue, int instant){
+    Device *disk = structures->devices->disk;
+    DiskState *state = structures->devices->diskState;
+    Statistics *statistics = structures->statistics;
+    if(!disk->actualProcess) return;
+
+    statistics->diskBusyTime++;
+    if(disk->remainingTime) return;
+
+    Process *process = disk->actualProcess;
+    disk->actualProcess = NULL;
+
+    for(; process; process = removeQueue(state->merged)){
+        addSample(statistics->diskLatency, instant - process->ioRequestTime);
+        statistics->diskRequests++;
+        returnProcess(structures->queues, returnQueue, process);
+        printf("- Processo %d saiu do dispositivo %s\n", process->pid, disk->name);
+    }
+}
@@ -0,0 +1,363 @@
+#include "../headers/fairshare.h"
+#include "../headers/scheduler.h"
+
+GroupScheduler* createGroupScheduler(Process *processes, int numProcesses);
+void destroyGroupScheduler(GroupScheduler **groups);
+Group* findGroup(GroupScheduler *groups, int id);
+Group* addGroup(GroupScheduler *groups, int id, int weight, int quota, int parentId);
+void readGroupsFile(GroupScheduler *groups);
+void linkGroups(GroupScheduler *groups);
+int compareGroups(Group *a, Group *b);
+void swapGroups(GroupHeap *level, int i, int j);
+void siftGroupUp(GroupHeap *level, int i);
+void siftGroupDown(GroupHeap *level, int i);
+void pushGroup(Group *group);
+void removeGroup(Group *group);
+void activateGroup(Group *group);
+void deactivateGroup(Group *group);
+int isGroupRunnable(Group *group);
+void addGroupQueue(GroupScheduler *groups, Process *process, int priority, int front);
+void checkGroupStart(StructureCollection *structures, int instant);
+void chargeGroup(StructureCollection *structures, Device *cpu, Group *group, int instant);
+void refreshGroupQuotas(GroupScheduler *groups, int instant);
+void printGroupStatistics(GroupScheduler *groups, int instants);
+
+/*
+ * Busca um grupo pelo id
+ */
+Group* findGroup(GroupScheduler *groups, int id){
+    for(int i = 0; i < groups->numGroups; i++)
+        if(groups->groups[i].id == id) return &groups->groups[i];
+    return NULL;
+}
+
+/*
+ * Adiciona um grupo novo ou atualiza o peso, a cota e o pai de um grupo existente
+ */
+Group* addGroup(GroupScheduler *groups, int id, int weight, int quota, int parentId){
+    Group *group = findGroup(groups, id);
+    if(!group){
+        group = &groups->groups[groups->numGroups++];
+        group->id = id;
+        group->parent = NULL;
+        group->level = &groups->root;
+        group->children.heap = NULL;
+        group->children.size = 0;
+        group->children.minVirtualTime = 0;
+        group->numChildren = 0;
+        group->virtualTime = 0;
+        group->usedInPeriod = 0;
+        group->throttled = 0;
+        group->throttleStart = 0;
+        group->heapIndex = -1;
+        group->cpuTime = 0;
+        group->throttleEvents = 0;
+        group->throttledTime = 0;
+        group->highPriority = createQueue();
+        group->lowPriority = createQueue();
+    }
+    group->weight = weight > 0 ? weight : DEFAULT_GROUP_WEIGHT;
+    group->quota = quota;
+    group->parentId = parentId;
+
+    return group;
+}
+
+/*
+ * Le os pesos, cotas e pais dos grupos do arquivo groups.txt (linhas "id, peso, cota" ou "id, peso, cota, pai"), se existir
+ */
+void readGroupsFile(GroupScheduler *groups){
+    FILE *ptr = fopen("../in/groups.txt", "r");
+    if(!ptr) return;
+
+    char *line = NULL;
+    size_t len = 0;
+    int id, weight, quota, parentId;
+    while(getline(&line, &len, ptr) != -1){
+        parentId = -1;
+        if(sscanf(line, " %d , %d , %d , %d", &id, &weight, &quota, &parentId) < 3) break;
+        if(groups->numGroups == MAX_GROUPS && !findGroup(groups, id)) break;
+        addGroup(groups, id, weight, quota, parentId);
+    }
+    fclose(ptr);
+    if(line) free(line);
+}
+
+/*
+ * Liga cada grupo ao seu pai e cria o heap de subgrupos de cada nivel. Grupos sem pai ficam na raiz
+ */
+void linkGroups(GroupScheduler *groups){
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *group = &groups->groups[i];
+        if(group->parentId < 0) continue;
+
+        group->parent = findGroup(groups, group->parentId);
+        if(!group->parent) exitProgram(INVALID_ARGUMENT, "O grupo pai informado em groups.txt nao existe");
+        group->parent->numChildren++;
+    }
+
+    // Subindo pelos pais, um grupo chega na raiz em menos de numGroups passos
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *ancestor = &groups->groups[i];
+        for(int depth = 0; ancestor; depth++, ancestor = ancestor->parent)
+            if(depth == groups->numGroups) exitProgram(INVALID_ARGUMENT, "A hierarquia de grupos em groups.txt possui um ciclo");
+    }
+
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *group = &groups->groups[i];
+        if(group->numChildren) group->children.heap = (Group **)malloc(sizeof(Group *) * group->numChildren);
+        if(group->parent) group->level = &group->parent->children;
+    }
+}
+
+/*
+ * Cria os grupos a partir do arquivo de grupos e do ppid de cada processo
+ */
+GroupScheduler* createGroupScheduler(Process *processes, int numProcesses){
+    GroupScheduler *groups = (GroupScheduler *)malloc(sizeof(GroupScheduler));
+    groups->groups = (Group *)malloc(sizeof(Group) * MAX_GROUPS);
+    groups->root.heap = (Group **)malloc(sizeof(Group *) * MAX_GROUPS);
+    groups->numGroups = 0;
+    groups->root.size = 0;
+    groups->root.minVirtualTime = 0;
+
+    readGroupsFile(groups);
+
+    for(int i = 0; i < numProcesses; i++){
+        Group *group = findGroup(groups, processes[i].ppid);
+        if(!group && groups->numGroups == MAX_GROUPS) exitProgram(INVALID_ARGUMENT, "Existem mais grupos do que o maximo permitido");
+        if(!group) group = addGroup(groups, processes[i].ppid, DEFAULT_GROUP_WEIGHT, 0, -1);
+        processes[i].group = group;
+    }
+
+    // Como no cgroup v2, os processos ficam so nas folhas: um grupo com subgrupos reparte a CPU entre eles
+    linkGroups(groups);
+    for(int i = 0; i < numProcesses; i++)
+        if(processes[i].group->numChildren) exitProgram(INVALID_ARGUMENT, "Processos so podem pertencer a grupos sem subgrupos");
+
+    printf("=== Compartilhamento justo com %d grupo(s) ===\n", groups->numGroups);
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *group = &groups->groups[i];
+        if(group->parent) printf("-> Grupo %d (subgrupo de %d): ", group->id, group->parent->id);
+        else printf("-> Grupo %d: ", group->id);
+        if(group->quota) printf("peso %d, cota de %d ut a cada %d ut\n", group->weight, group->quota, QUOTA_PERIOD);
+        else printf("peso %d, sem cota\n", group->weight);
+    }
+    printf("\n");
+
+    return groups;
+}
+
+/*
+ * Libera os grupos
+ */
+void destroyGroupScheduler(GroupScheduler **groups){
+    for(int i = 0; i < (*groups)->numGroups; i++){
+        free((*groups)->groups[i].highPriority);
+        free((*groups)->groups[i].lowPriority);
+        free((*groups)->groups[i].children.heap);
+    }
+    free((*groups)->groups);
+    free((*groups)->root.heap);
+    free(*groups);
+    *groups = NULL;
+}
+
+/*
+ * Ordem do heap: menor tempo virtual, desempatando pelo id
+ */
+int compareGroups(Group *a, Group *b){
+    if(a->virtualTime != b->virtualTime) return a->virtualTime < b->virtualTime ? -1 : 1;
+    return a->id - b->id;
+}
+
+void swapGroups(GroupHeap *level, int i, int j){
+    Group *aux = level->heap[i];
+    level->heap[i] = level->heap[j];
+    level->heap[j] = aux;
+    level->heap[i]->heapIndex = i;
+    level->heap[j]->heapIndex = j;
+}
+
+void siftGroupUp(GroupHeap *level, int i){
+    while(i > 0 && compareGroups(level->heap[i], level->heap[(i - 1) / 2]) < 0){
+        swapGroups(level, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+void siftGroupDown(GroupHeap *level, int i){
+    while(2 * i + 1 < level->size){
+        int child = 2 * i + 1;
+        if(child + 1 < level->size && compareGroups(level->heap[child + 1], level->heap[child]) < 0) child++;
+        if(compareGroups(level->heap[i], level->heap[child]) <= 0) break;
+
+        swapGroups(level, i, child);
+        i = child;
+    }
+}
+
+/*
+ * Insere o grupo no heap do seu nivel em O(log g). Um grupo que estava ocioso nao acumula credito:
+ * seu tempo virtual e no minimo o do ultimo grupo escalonado no nivel
+ */
+void pushGroup(Group *group){
+    GroupHeap *level = group->level;
+    if(group->heapIndex != -1 || group->throttled) return;
+
+    if(group->virtualTime < level->minVirtualTime) group->virtualTime = level->minVirtualTime;
+    group->heapIndex = level->size++;
+    level->heap[group->heapIndex] = group;
+    siftGroupUp(level, group->heapIndex);
+}
+
+/*
+ * Remove o grupo do heap do seu nivel em O(log g)
+ */
+void removeGroup(Group *group){
+    GroupHeap *level = group->level;
+    int i = group->heapIndex;
+    if(i == -1) return;
+
+    group->heapIndex = -1;
+    if(i == --level->size) return;
+
+    level->heap[i] = level->heap[level->size];
+    level->heap[i]->heapIndex = i;
+    siftGroupUp(level, i);
+    siftGroupDown(level, level->heap[i]->heapIndex);
+}
+
+/*
+ * Torna o grupo escalonavel e sobe pelos pais, parando no primeiro que ja esta no heap ou esta limitado
+ */
+void activateGroup(Group *group){
+    for(; group; group = group->parent){
+        if(group->heapIndex != -1 || group->throttled || !isGroupRunnable(group)) return;
+        pushGroup(group);
+    }
+}
+
+/*
+ * Retira o grupo do heap do seu nivel e sobe pelos pais que ficaram sem subgrupos prontos
+ */
+void deactivateGroup(Group *group){
+    for(; group; group = group->parent){
+        removeGroup(group);
+        if(!group->parent || isGroupRunnable(group->parent)) return;
+    }
+}
+
+int isGroupRunnable(Group *group){
+    return group->highPriority->head || group->lowPriority->head || group->children.size;
+}
+
+/*
+ * Adiciona o processo na fila circular do seu grupo, tornando o grupo escalonavel
+ */
+void addGroupQueue(GroupScheduler *groups, Process *process, int priority, int front){
+    Group *group = process->group;
+    ProcessQueueDescriptor *queue = priority == HIGH_PRIORITY ? group->highPriority : group->lowPriority;
+
+    if(front) addQueueFront(queue, process);
+    else addQueue(queue, process);
+
+    activateGroup(group);
+}
+
+/*
+ * Desce da raiz pelo grupo de menor tempo virtual de cada nivel ate uma folha e coloca na CPU
+ * um processo dela, respeitando as filas com feedback do grupo
+ */
+void checkGroupStart(StructureCollection *structures, int instant){
+    Device *cpu = structures->devices->cpu;
+    GroupScheduler *groups = structures->queues->groups;
+    if(cpu->actualProcess) return;
+
+    if(!groups->root.size){
+        cpu->remainingTime = cpu->duration;
+        return;
+    }
+
+    GroupHeap *level = &groups->root;
+    Group *group = level->heap[0];
+    level->minVirtualTime = group->virtualTime;
+    while(group->children.size){
+        level = &group->children;
+        group = level->heap[0];
+        level->minVirtualTime = group->virtualTime;
+    }
+
+    Process *process = removeQueue(group->highPriority);
+    if(!process) process = removeQueue(group->lowPriority);
+    if(!isGroupRunnable(group)) deactivateGroup(group);
+
+    dispatchCPU(cpu, process, structures->statistics, instant);
+}
+
+/*
+ * Contabiliza uma ut de CPU para o grupo e seus ancestrais, cada um no heap do seu nivel,
+ * e limita os que esgotaram sua cota no periodo
+ */
+void chargeGroup(StructureCollection *structures, Device *cpu, Group *group, int instant){
+    int throttled = 0;
+    for(Group *ancestor = group; ancestor; ancestor = ancestor->parent){
+        ancestor->cpuTime++;
+        ancestor->usedInPeriod++;
+        ancestor->virtualTime += VIRTUAL_TIME_SCALE / ancestor->weight;
+        if(ancestor->heapIndex != -1) siftGroupDown(ancestor->level, ancestor->heapIndex);
+
+        if(!ancestor->quota || ancestor->usedInPeriod < ancestor->quota || ancestor->throttled) continue;
+
+        printf("! Grupo %d esgotou sua cota de %d ut e foi limitado ate o proximo periodo\n", ancestor->id, ancestor->quota);
+        ancestor->throttled = 1;
+        ancestor->throttleStart = instant + 1;
+        ancestor->throttleEvents++;
+        deactivateGroup(ancestor);
+        throttled = 1;
+    }
+
+    // O processo do grupo que ainda estiver na CPU e preemptado e espera o fim da limitacao na sua folha
+    if(throttled && cpu->actualProcess && cpu->actualProcess->group == group && !cpu->actualProcess->realTime){
+        addQueueFront(group->highPriority, cpu->actualProcess);
+        releaseCPUs(structures->devices, cpu->actualProcess);
+        activateGroup(group);
+    }
+}
+
+/*
+ * No inicio de cada periodo zera as cotas usadas e libera os grupos limitados
+ */
+void refreshGroupQuotas(GroupScheduler *groups, int instant){
+    if(instant % QUOTA_PERIOD) return;
+
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *group = &groups->groups[i];
+        group->usedInPeriod = 0;
+        if(!group->throttled) continue;
+
+        group->throttled = 0;
+        group->throttledTime += instant - group->throttleStart;
+        activateGroup(group);
+    }
+}
+
+/*
+ * Imprime o tempo de CPU e a limitacao de cada grupo
+ */
+void printGroupStatistics(GroupScheduler *groups, int instants){
+    // O tempo de um grupo inclui o dos subgrupos, entao o total soma so a raiz
+    int totalTime = 0;
+    for(int i = 0; i < groups->numGroups; i++)
+        if(!groups->groups[i].parent) totalTime += groups->groups[i].cpuTime;
+
+    for(int i = 0; i < groups->numGroups; i++){
+        Group *group = &groups->groups[i];
+        if(group->parent) printf("-> Grupo %d (subgrupo de %d, peso %d): %d ut de CPU (%.2f%% do uso), limitado %d vez(es) por %d ut\n", group->id, group->parent->id, group->weight,
+            group->cpuTime, totalTime ? 100.0 * group->cpuTime / totalTime : 0, group->throttleEvents,
+            group->throttledTime + (group->throttled ? instants - group->throttleStart : 0));
+        else printf("-> Grupo %d (peso %d): %d ut de CPU (%.2f%% do uso), limitado %d vez(es) por %d ut\n", group->id, group->weight,
+            group->cpuTime, totalTime ? 100.0 * group->cpuTime / totalTime : 0, group->throttleEvents,
+            group->throttledTime + (group->throttled ? instants - group->throttleStart : 0));
+    }
+}
@@ -0,0 +1,71 @@
+#include "../headers/gang.h"
+#include "../headers/scheduler.h"
+
+void checkGangStart(StructureCollection *structures, int instant);
+int countFreeCPUs(DeviceCollection *devices);
+void dispatchThreads(StructureCollection *structures, Process *process, int cpus, int instant);
+int dispatchQueue(StructureCollection *structures, ProcessQueueDescriptor *queue, int *freeCpus, int instant);
+
+int countFreeCPUs(DeviceCollection *devices){
+    int freeCpus = 0;
+    for(int i = 0; i < devices->numCpus; i++)
+        if(!devices->cpus[i]->actualProcess) freeCpus++;
+    return freeCpus;
+}
+
+/*
+ * Coloca as threads do processo em CPUs livres, preferindo as CPUs onde ele executou por ultimo
+ */
+void dispatchThreads(StructureCollection *structures, Process *process, int cpus, int instant){
+    DeviceCollection *devices = structures->devices;
+
+    for(int pass = 0; pass < 2 && cpus; pass++){
+        for(int i = 0; i < devices->numCpus && cpus; i++){
+            Device *cpu = devices->cpus[i];
+            if(cpu->actualProcess || (pass == 0 && cpu->lastProcess != process)) continue;
+
+            dispatchCPU(cpu, process, structures->statistics, instant);
+            cpus--;
+        }
+    }
+}
+
+/*
+ * Coloca os processos da fila enquanto houver CPUs. Na gangue estrita todas as threads
+ * entram juntas ou nenhuma entra, e o processo no inicio da fila bloqueia os seguintes.
+ * Retorna 1 se a fila ficou bloqueada
+ */
+int dispatchQueue(StructureCollection *structures, ProcessQueueDescriptor *queue, int *freeCpus, int instant){
+    while(*freeCpus && queue->head){
+        Process *process = queue->head->process;
+        int needed = process->threads < NUM_CPUS ? process->threads : NUM_CPUS;
+
+        int granted = needed;
+        if(needed > *freeCpus) granted = COSCHEDULING == RELAXED_COSCHEDULING ? *freeCpus : 0;
+        if(!granted) return 1;
+
+        if(granted < needed){
+            structures->statistics->partialDispatches++;
+            printf("~ Processo %d coescalonado com %d de %d thread(s)\n", process->pid, granted, process->threads);
+        }
+
+        removeQueue(queue);
+        dispatchThreads(structures, process, granted, instant);
+        *freeCpus -= granted;
+    }
+    return 0;
+}
+
+/*
+ * Verifica se ha processos para entrada nas CPUs e contabiliza as CPUs que ficaram ociosas
+ */
+void checkGangStart(StructureCollection *structures, int instant){
+    QueueCollection *queues = structures->queues;
+    int freeCpus = countFreeCPUs(structures->devices);
+
+    if(!dispatchQueue(structures, queues->highPriority, &freeCpus, instant))
+        dispatchQueue(structures, queues->lowPriority, &freeCpus, instant);
+
+    if(queues->highPriority->head || queues->lowPriority->head) structures->statistics->fragmentedCpuTime += freeCpus;
+    else structures->statistics->idleCpuTime += freeCpus;
+}
@@ -0,0 +1,306 @@
+#include "../headers/live.h"
+#include <sys/wait.h>
+#include <time.h>
+
+LiveTask *liveTasks;
+
+void liveExecute(StructureCollection *structures);
+void simulatePredictions(StructureCollection *structures, LiveTask *tasks);
+double elapsedMs(struct timespec *start);
+void sleepUntil(struct timespec *start, double ms);
+void burnTimeUnit();
+void runLiveTask(int index);
+void* runLiveWorker(void *argument);
+void* runLiveDevice(void *argument);
+Process* nextLiveProcess(QueueCollection *queues);
+void printLiveComparison(LiveExecutor *executor);
+
+/*
+ * Tempo real em ms desde o inicio
+ */
+double elapsedMs(struct timespec *start){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1000000.0;
+}
+
+/*
+ * Dorme ate o instante real (em ms desde o inicio)
+ */
+void sleepUntil(struct timespec *start, double ms){
+    struct timespec wakeup = *start;
+    long nanoseconds = (long)(ms * 1000000.0);
+    wakeup.tv_sec += nanoseconds / 1000000000L;
+    wakeup.tv_nsec += nanoseconds % 1000000000L;
+    if(wakeup.tv_nsec >= 1000000000L){
+        wakeup.tv_sec++;
+        wakeup.tv_nsec -= 1000000000L;
+    }
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, NULL));
+}
+
+/*
+ * Consome uma ut de tempo de CPU da thread atual
+ */
+void burnTimeUnit(){
+    struct timespec begin, now;
+    long target = LIVE_TIME_UNIT * 1000000L;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &begin);
+
+    do{
+        for(volatile int i = 0; i < 1000; i++);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    }while((now.tv_sec - begin.tv_sec) * 1000000000L + (now.tv_nsec - begin.tv_nsec) < target);
+}
+
+/*
+ * Corpo da tarefa: consome uma ut de CPU e devolve o controle ao worker, que decide se continua
+ */
+void runLiveTask(int index){
+    LiveTask *task = &liveTasks[index];
+    for(;;){
+        burnTimeUnit();
+        swapcontext(&task->context, task->returnContext);
+    }
+}
+
+/*
+ * Proximo processo das filas com feedback (alta prioridade primeiro)
+ */
+Process* nextLiveProcess(QueueCollection *queues){
+    if(queues->highPriority->head) return removeQueue(queues->highPriority);
+    if(queues->lowPriority->head) return removeQueue(queues->lowPriority);
+    return NULL;
+}
+
+/*
+ * Worker que faz o papel de uma CPU: retira um processo das filas e executa sua tarefa ate o fim
+ * do quantum real, de um IO ou do processo, aplicando as mesmas regras da simulacao
+ */
+void* runLiveWorker(void *argument){
+    LiveWorker *worker = (LiveWorker *)argument;
+    LiveExecutor *executor = worker->executor;
+    QueueCollection *queues = executor->structures->queues;
+
+    pthread_mutex_lock(&executor->lock);
+    while(!executor->stop){
+        Process *process = nextLiveProcess(queues);
+        if(!process){
+            pthread_cond_wait(&executor->changed, &executor->lock);
+            continue;
+        }
+
+        LiveTask *task = &executor->tasks[process - executor->structures->processes];
+        double sliceEnd = elapsedMs(&executor->start) + TIME_SLICE * LIVE_TIME_UNIT;
+        if(task->firstRun < 0) task->firstRun = elapsedMs(&executor->start);
+        pthread_mutex_unlock(&executor->lock);
+
+        int finished = 0, io = 0;
+        task->returnContext = &worker->context;
+        while(!finished && !io){
+            swapcontext(&worker->context, &task->context);
+            process->processedTime++;
+
+            finished = process->processedTime == process->serviceTime;
+            io = !finished && process->IO && process->IO->initialTime == process->processedTime;
+            if(elapsedMs(&executor->start) >= sliceEnd) break;
+        }
+
+        pthread_mutex_lock(&executor->lock);
+        if(finished){
+            task->finish = elapsedMs(&executor->start);
+            executor->finishedProcesses++;
+        }else if(io){
+            ProcessQueueDescriptor *device = process->IO->deviceQueue;
+            process->IO++;
+            addQueue(device, process);
+        }else{
+            returnProcess(queues, queues->lowPriority, process);
+        }
+        pthread_cond_broadcast(&executor->changed);
+    }
+    pthread_mutex_unlock(&executor->lock);
+    return NULL;
+}
+
+/*
+ * Thread de um dispositivo de IO: atende a fila em ordem de chegada dormindo pelo tempo da operacao
+ */
+void* runLiveDevice(void *argument){
+    LiveDevice *device = (LiveDevice *)argument;
+    LiveExecutor *executor = device->executor;
+
+    pthread_mutex_lock(&executor->lock);
+    while(!executor->stop){
+        if(!device->queue->head){
+            pthread_cond_wait(&executor->changed, &executor->lock);
+            continue;
+        }
+
+        Process *process = removeQueue(device->queue);
+        pthread_mutex_unlock(&executor->lock);
+
+        struct timespec duration = {0, 0};
+        long nanoseconds = device->device->duration * LIVE_TIME_UNIT * 1000000L;
+        duration.tv_sec = nanoseconds / 1000000000L;
+        duration.tv_nsec = nanoseconds % 1000000000L;
+        while(nanosleep(&duration, &duration));
+
+        pthread_mutex_lock(&executor->lock);
+        returnProcess(executor->structures->queues, feedbackQueue(executor->structures->queues, device->returnPriority), process);
+        pthread_cond_broadcast(&executor->changed);
+    }
+    pthread_mutex_unlock(&executor->lock);
+    return NULL;
+}
+
+/*
+ * Executa a simulacao em um processo filho, que herda uma copia intacta da carga de trabalho,
+ * e recebe o turnaround e o tempo de resposta previstos para cada processo
+ */
+void simulatePredictions(StructureCollection *structures, LiveTask *tasks){
+    int size = sizeof(int) * 2 * structures->numProcesses;
+    int *predictions = (int *)malloc(size);
+    int fd[2];
+    if(pipe(fd)) exitProgram(FILE_ERROR, "Falha ao criar pipe para a simulacao");
+
+    fflush(stdout);
+    pid_t child = fork();
+    if(child < 0) exitProgram(FILE_ERROR, "Falha ao criar processo para a simulacao");
+    if(child == 0){
+        close(fd[0]);
+        if(!freopen("/dev/null", "w", stdout)) _exit(FILE_ERROR);
+        scheduler(structures);
+
+        for(int i = 0; i < structures->numProcesses; i++){
+            Process *process = &structures->processes[i];
+            predictions[2 * i] = process->finishTime - process->arrivalTime;
+            predictions[2 * i + 1] = process->firstRunTime - process->arrivalTime;
+        }
+        if(write(fd[1], predictions, size) != size) _exit(FILE_ERROR);
+        _exit(NO_ERROR);
+    }
+    close(fd[1]);
+
+    int received = 0, bytes;
+    while(received < size && (bytes = read(fd[0], (char *)predictions + received, size - received)) > 0) received += bytes;
+    close(fd[0]);
+    waitpid(child, NULL, 0);
+    if(received != size) exitProgram(FILE_ERROR, "Falha ao receber a simulacao");
+
+    for(int i = 0; i < structures->numProcesses; i++){
+        tasks[i].simulatedTurnaround = predictions[2 * i];
+        tasks[i].simulatedResponse = predictions[2 * i + 1];
+    }
+    free(predictions);
+}
+
+/*
+ * Compara as metricas previstas pela simulacao com as medidas na execucao real
+ */
+void printLiveComparison(LiveExecutor *executor){
+    StructureCollection *structures = executor->structures;
+    double simulatedTotal = 0, measuredTotal = 0, responseError = 0;
+
+    printf("=== Execucao real x simulacao (1 ut = %d ms, %d CPU(s)) ===\n", LIVE_TIME_UNIT, structures->devices->numCpus);
+    for(int i = 0; i < structures->numProcesses; i++){
+        LiveTask *task = &executor->tasks[i];
+        double turnaround = (task->finish - task->arrival) / LIVE_TIME_UNIT;
+        double response = (task->firstRun - task->arrival) / LIVE_TIME_UNIT;
+
+        printf("-> Processo %d: turnaround simulado %d ut, medido %.2f ut (%+.1f%%); resposta simulada %d ut, medida %.2f ut\n",
+            task->process->pid, task->simulatedTurnaround, turnaround,
+            task->simulatedTurnaround ? 100.0 * (turnaround - task->simulatedTurnaround) / task->simulatedTurnaround : 0,
+            task->simulatedResponse, response);
+
+        simulatedTotal += task->simulatedTurnaround;
+        measuredTotal += turnaround;
+        responseError += response - task->simulatedResponse;
+    }
+
+    printf("-> Turnaround medio: simulado %.2f ut, medido %.2f ut\n", simulatedTotal / structures->numProcesses, measuredTotal / structures->numProcesses);
+    printf("-> Erro medio do tempo de resposta: %+.2f ut\n", responseError / structures->numProcesses);
+    printf("-> Calibracao: 1 ut simulada de turnaround corresponde a %.3f ms reais\n", simulatedTotal ? measuredTotal * LIVE_TIME_UNIT / simulatedTotal : 0);
+}
+
+/*
+ * Executa a carga de trabalho com tarefas reais: cada processo e uma tarefa ucontext que consome CPU,
+ * as CPUs sao threads workers com quantum medido em tempo real e os IOs sao threads que dormem
+ */
+void liveExecute(StructureCollection *structures){
+    // Os workers so aplicam as filas com feedback: a carga do arquivo nao pode ter deadlines nem threads
+    for(int i = 0; i < structures->numProcesses; i++){
+        Process *process = &structures->processes[i];
+        if(process->deadline || process->threads > 1) exitProgram(INVALID_ARGUMENT, "A execucao real nao suporta processos com deadline ou com varias threads");
+    }
+
+    LiveExecutor executor;
+    executor.structures = structures;
+    executor.tasks = (LiveTask *)malloc(sizeof(LiveTask) * structures->numProcesses);
+    executor.finishedProcesses = 0;
+    executor.stop = 0;
+    liveTasks = executor.tasks;
+
+    simulatePredictions(structures, executor.tasks);
+
+    for(int i = 0; i < structures->numProcesses; i++){
+        LiveTask *task = &executor.tasks[i];
+        task->process = &structures->processes[i];
+        task->stack = (char *)malloc(LIVE_STACK_SIZE);
+        task->firstRun = -1;
+        getcontext(&task->context);
+        task->context.uc_stack.ss_sp = task->stack;
+        task->context.uc_stack.ss_size = LIVE_STACK_SIZE;
+        task->context.uc_link = NULL;
+        makecontext(&task->context, (void (*)(void))runLiveTask, 1, i);
+    }
+
+    pthread_mutex_init(&executor.lock, NULL);
+    pthread_cond_init(&executor.changed, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &executor.start);
+
+    DeviceCollection *devices = structures->devices;
+    QueueCollection *queues = structures->queues;
+    LiveDevice liveDevices[3] = {
+        {0, devices->disk, queues->diskQueue, DISK_RETURN, &executor},
+        {0, devices->tape, queues->tapeQueue, TAPE_RETURN, &executor},
+        {0, devices->printer, queues->printerQueue, PRINTER_RETURN, &executor}
+    };
+    for(int i = 0; i < 3; i++){
+        executor.devices[i] = liveDevices[i];
+        pthread_create(&executor.devices[i].thread, NULL, runLiveDevice, &executor.devices[i]);
+    }
+    for(int i = 0; i < devices->numCpus; i++){
+        executor.workers[i].executor = &executor;
+        pthread_create(&executor.workers[i].thread, NULL, runLiveWorker, &executor.workers[i]);
+    }
+
+    // A thread principal faz as chegadas nos instantes reais correspondentes
+    for(int i = 0; i < structures->numProcesses; i++){
+        Process *process = &structures->processes[i];
+        sleepUntil(&executor.start, (double)process->arrivalTime * LIVE_TIME_UNIT);
+
+        pthread_mutex_lock(&executor.lock);
+        executor.tasks[i].arrival = elapsedMs(&executor.start);
+        returnProcess(queues, queues->highPriority, process);
+        printf("Processo %d chegou em %.2f ms\n", process->pid, executor.tasks[i].arrival);
+        pthread_cond_broadcast(&executor.changed);
+        pthread_mutex_unlock(&executor.lock);
+    }
+
+    pthread_mutex_lock(&executor.lock);
+    while(executor.finishedProcesses < structures->numProcesses) pthread_cond_wait(&executor.changed, &executor.lock);
+    executor.stop = 1;
+    pthread_cond_broadcast(&executor.changed);
+    pthread_mutex_unlock(&executor.lock);
+
+    for(int i = 0; i < devices->numCpus; i++) pthread_join(executor.workers[i].thread, NULL);
+    for(int i = 0; i < 3; i++) pthread_join(executor.devices[i].thread, NULL);
+
+    printLiveComparison(&executor);
+
+    for(int i = 0; i < structures->numProcesses; i++) free(executor.tasks[i].stack);
+    free(executor.tasks);
+    pthread_mutex_destroy(&executor.lock);
+    pthread_cond_destroy(&executor.changed);
+}
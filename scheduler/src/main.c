@@ -6,7 +6,9 @@ int main(int argc, char *argv[]){
     readArgumentsFromConsole(argc, argv);
     int readProcessesFrom = showMenu();
     StructureCollection *structures = createStructures(readProcessesFrom);
-    scheduler(structures);
+    if(TUNE_OBJECTIVE) autoTune(structures);
+    else if(LIVE_TIME_UNIT) liveExecute(structures);
+    else scheduler(structures);
     destroyStructures(&structures);
     return NO_ERROR;
 }
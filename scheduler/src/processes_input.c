@@ -1,7 +1,8 @@
 #include "../headers/processes_input.h"
+#include "../headers/disk.h"
 
 char* trim(char* str);
-Process newProcess(int pid, int arrivalTime, int serviceTime, int numIO, IOElement *IO);
+Process newProcess(int pid, int arrivalTime, int serviceTime, int numIO, IOElement *IO, int deadline, int period, int group, int threads);
 Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues);
 Process* createProcessesFromKeyboard(int *numProcesses, QueueCollection *queues) ;
 Process* createRandomProcesses(int *numProcesses, QueueCollection *queues);
@@ -35,24 +36,42 @@ char* trim(char* str) {
 /*
  * Cria um novo processo dada suas informacoes
  */
-Process newProcess(int pid, int arrivalTime, int serviceTime, int numIO, IOElement *IO) {
+Process newProcess(int pid, int arrivalTime, int serviceTime, int numIO, IOElement *IO, int deadline, int period, int group, int threads) {
     printf("=== Criando o processo %d ===\n", pid);
     Process process;
     process.pid = pid;
+    process.ppid = group;
+    process.group = NULL;
+    process.threads = threads > 0 ? threads : 1;
+    process.runningThreads = 0;
+    process.threadProgress = 0;
     process.status = READY; 
     process.priority = HIGH_PRIORITY;
     process.arrivalTime = arrivalTime;
     process.processedTime = 0;
     process.serviceTime = serviceTime;
+    process.finishTime = 0;
+    process.firstRunTime = -1;
+    process.lastRunTime = -1;
+    process.ioBlock = 0;
+    process.ioRequestTime = 0;
+    process.deadline = deadline;
+    process.period = period;
+    process.absoluteDeadline = 0;
+    process.realTime = 0;
     process.actualIO = 0;
     process.numIO = numIO;
     process.IO = IO;
 
     printf("-> Tempo de chegada: %d \n-> Tempo de serviço: %d \n-> Quantidade de IOs: %d \n", arrivalTime, serviceTime, numIO);
+    if(FAIR_SHARE) printf("-> Grupo: %d \n", group);
+    printf("-> Threads: %d \n", process.threads);
+    if(deadline) printf("-> Deadline: %d \n-> Periodo: %d \n", deadline, period ? period : deadline);
     IOElement *IOPtr = IO;
 
     for (int i = 0; i < numIO; i++) {
-        printf("-> IO do tipo %s no instante %d\n", IOPtr->type, IOPtr->initialTime);
+        if(strcmp(IOPtr->type, "disco")) printf("-> IO do tipo %s no instante %d\n", IOPtr->type, IOPtr->initialTime);
+        else printf("-> IO do tipo %s no instante %d (bloco %d)\n", IOPtr->type, IOPtr->initialTime, IOPtr->block);
         IOPtr++;
     }
 
@@ -104,9 +123,32 @@ Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues) {
         IOElement *IO = NULL;
         int numIO = 0;
 
+        // Campos opcionais: lista de IO, deadline/periodo de tempo real (ex.: @12 ou @12:30) e grupo (ex.: #2) e threads (ex.: *4)
+        char *IOField = NULL;
+        int deadline = 0, period = 0, group = 0, threads = 1;
+        while(pt){
+            char *field = pt;
+            pt = strtok(NULL, ",");
+            while(*field == ' ') field++;
+
+            if(*field == '@'){
+                if(NUM_CPUS > 1) exitProgram(INVALID_ARGUMENT, "A classe de tempo real so e suportada com uma CPU. Verifique o arquivo 'input.txt'.");
+                char *end;
+                deadline = strtol(field + 1, &end, 10);
+                if(*end == ':'){
+                    period = strtol(end + 1, &end, 10);
+                    if(period <= 0 || period < serviceTime) exitProgram(INVALID_ARGUMENT, "Argumento inválido. O periodo deve ser positivo e no minimo o tempo de servico. Verifique o arquivo 'input.txt'.");
+                }
+                while(*end == ' ' || *end == '\r' || *end == '\n') end++;
+                if(deadline <= 0 || *end) exitProgram(INVALID_ARGUMENT, "Argumento inválido. O deadline deve ser um numero positivo no formato @deadline ou @deadline:periodo. Verifique o arquivo 'input.txt'.");
+            } else if(*field == '#') group = atoi(field + 1);
+            else if(*field == '*') threads = atoi(field + 1);
+            else IOField = field;
+        }
+
         // Se tiver IO
-        if(pt){
-            char *IOLine = trim(pt);
+        if(IOField){
+            char *IOLine = trim(IOField);
             pt = strtok(IOLine, "/");
             IO = (IOElement *) malloc(sizeof(IOElement) * MAX_IO); // crio o array de elementos de fila de IO
             IOElement *IOPtr = IO;
@@ -118,8 +160,11 @@ Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues) {
                     pt = strtok(NULL, "/");
                 } else break;
 
+                // Formato: tipo-instante, com bloco opcional para disco (ex.: D-2:150)
                 char IOType = part[0];
-                int IOInitialTime = part[2] - '0';
+                char *end;
+                int IOInitialTime = strtol(part + 2, &end, 10);
+                int IOBlock = *end == ':' ? atoi(end + 1) % DISK_BLOCKS : 0;
 
                 // Crio um elemento da fila de IO
                 IOElement element;
@@ -140,6 +185,7 @@ Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues) {
                         exitProgram(INVALID_OPTION, "Opcao invalida. Escolha uma das seguintes opcoes: 1, 2 ou 3.");
                 }
                 element.initialTime = IOInitialTime;
+                element.block = IOBlock;
 
                 if (isSameInstant(IO, IOInitialTime, numIO)) {
                     exitProgram(INVALID_ARGUMENT, "Argumento inválido. Duas operações de IO não podem começar ao mesmo tempo. Verifique o arquivo 'input.txt'.");
@@ -160,7 +206,7 @@ Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues) {
             break;
         }
 
-        *processesPtr = newProcess(pid, arrivalTime, serviceTime, numIO, IO);
+        *processesPtr = newProcess(pid, arrivalTime, serviceTime, numIO, IO, deadline, period, group, threads);
         processesPtr++;
     }
     
@@ -176,7 +222,7 @@ Process* createProcessesFromFile(int *numProcesses, QueueCollection *queues) {
  */
 Process* createProcessesFromKeyboard(int *numProcesses, QueueCollection *queues) {
     int i, numIO;
-    long choice, arrivalTime, serviceTime;
+    long choice, arrivalTime, serviceTime, deadline, period, group, threads;
     int noMoreIO = 0;
     Process *processes = (Process *) malloc(sizeof(Process) * MAX_PROCESSES);
     Process *processesPtr = processes;
@@ -199,6 +245,35 @@ Process* createProcessesFromKeyboard(int *numProcesses, QueueCollection *queues)
         while(readNumberWithMin(&serviceTime, 1)){
             printf("Entre com um numero\n");
         }
+        deadline = 0;
+        period = 0;
+        if(REAL_TIME_CLASS){
+            printf("Qual o deadline do processo, relativo a chegada? (0 para nenhum, minimo %ld)\n", serviceTime);
+            while(readNumberWithMin(&deadline, 0) || (deadline && deadline < serviceTime)){
+                printf("Entre com um numero valido\n");
+            }
+        }
+        if(deadline){
+            printf("Qual o periodo minimo entre chegadas? (0 para usar o deadline, minimo %ld)\n", serviceTime);
+            while(readNumberWithMin(&period, 0) || (period && period < serviceTime)){
+                printf("Entre com um numero valido\n");
+            }
+        }
+
+        group = 0;
+        if(FAIR_SHARE){
+            printf("Qual o grupo do processo? (Minimo 0)\n");
+            while(readNumberWithMin(&group, 0)){
+                printf("Entre com um numero\n");
+            }
+        }
+        threads = 1;
+        if((NUM_CPUS > 1 || COSCHEDULING == RELAXED_COSCHEDULING) && !LIVE_TIME_UNIT){
+            printf("Quantas threads o processo possui? (Minimo 1, Maximo %d)\n", MAX_CPUS);
+            while(readNumberInRange(&threads, 1, MAX_CPUS)){
+                printf("Entre com um numero\n");
+            }
+        }
 
         IOElement *IO = (IOElement *) malloc(sizeof(IOElement) * MAX_IO); // array de IO
         IOElement *IOPtr = IO;
@@ -251,15 +326,23 @@ Process* createProcessesFromKeyboard(int *numProcesses, QueueCollection *queues)
                 } while(sameTime);
 
                 element.initialTime = IOInitialTime;
+                element.block = 0;
 
-                
+                if(choice == 1){
+                    long IOBlock;
+                    printf("Qual o bloco alvo do disco? (Minimo 0, Maximo %d)\n", DISK_BLOCKS - 1);
+                    while(readNumberInRange(&IOBlock, 0, DISK_BLOCKS - 1)){
+                        printf("Entre com um numero\n");
+                    }
+                    element.block = IOBlock;
+                }
 
                 *IOPtr = element;
                 IOPtr++;			
             }
             sortIO(IO, numIO);
         }
-        *processesPtr = newProcess(i+1, arrivalTime, serviceTime, numIO, IO);
+        *processesPtr = newProcess(i+1, arrivalTime, serviceTime, numIO, IO, deadline, period, group, threads);
         processesPtr++;
     }
     *numProcesses = i;
@@ -321,13 +404,23 @@ Process* createRandomProcesses(int *numProcesses, QueueCollection *queues) {
                         exitProgram(INVALID_OPTION, "Opcao invalida. Erro ao gerar opcao de IO valida.");
                 }
                 element.initialTime = IOInitialTime;
+                element.block = rand() % DISK_BLOCKS;
                 *IOPtr = element;
                 IOPtr++;			
             }
             sortIO(IO, numIO);
         } else numIO = 0;
 
-        *processesPtr = newProcess(pid, arrivalTime, serviceTime, numIO, IO);
+        // Com a classe de tempo real, um terco dos processos recebe um deadline com alguma folga sobre o tempo de servico
+        int deadline = REAL_TIME_CLASS && rand() % 3 == 0 ? serviceTime + rand() % (3 * serviceTime + 1) : 0;
+
+        // Com varias CPUs ou coescalonamento relaxado, um quarto dos processos e paralelo, com 2 a 4 threads (exceto na execucao real)
+        int threads = (NUM_CPUS > 1 || COSCHEDULING == RELAXED_COSCHEDULING) && !LIVE_TIME_UNIT && rand() % 4 == 0 ? 2 + rand() % 3 : 1;
+
+        // Com o compartilhamento justo, os processos sao distribuidos entre tres grupos
+        int group = FAIR_SHARE ? rand() % 3 : 0;
+
+        *processesPtr = newProcess(pid, arrivalTime, serviceTime, numIO, IO, deadline, 0, group, threads);
         processesPtr++;
     }
     sortProcess(processes, *numProcesses);
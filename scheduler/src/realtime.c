@@ -0,0 +1,78 @@
+#include "../headers/realtime.h"
+#include "../headers/scheduler.h"
+
+void addRealTimeProcess(StructureCollection *structures, Process *process, ProcessQueueDescriptor *fallbackQueue);
+void checkRealTimeStart(StructureCollection *structures, int instant);
+void finishRealTimeProcess(StructureCollection *structures, Process *process);
+double processUtilization(Process *process);
+
+/*
+ * Fracao da CPU exigida pelo processo: servico / periodo (ou deadline se nao houver periodo)
+ */
+double processUtilization(Process *process){
+    int period = process->period ? process->period : process->deadline;
+    return (double)process->serviceTime / period;
+}
+
+/*
+ * Controle de admissao: o processo com deadline so entra na classe EDF se a utilizacao
+ * total continuar dentro do limite. Caso contrario ele e escalonado como um processo comum
+ */
+void addRealTimeProcess(StructureCollection *structures, Process *process, ProcessQueueDescriptor *fallbackQueue){
+    DeadlineHeap *heap = structures->queues->realTime;
+    double utilization = processUtilization(process);
+
+    structures->statistics->deadlineProcesses++;
+    process->absoluteDeadline = process->arrivalTime + process->deadline;
+
+    if(heap->utilization + utilization > RT_UTILIZATION_BOUND / 100.0){
+        printf("! Processo %d rejeitado na classe de tempo real (utilizacao %.2f + %.2f acima de %d%%)\n", process->pid, heap->utilization, utilization, RT_UTILIZATION_BOUND);
+        returnProcess(structures->queues, fallbackQueue, process);
+        return;
+    }
+
+    heap->utilization += utilization;
+    process->realTime = 1;
+    structures->statistics->admittedProcesses++;
+    pushDeadline(heap, process);
+    printf("Processo %d admitido na classe de tempo real com deadline %d\n", process->pid, process->absoluteDeadline);
+}
+
+/*
+ * Coloca na CPU o processo de tempo real de menor deadline, preemptando o processo atual
+ * se ele for da fila circular ou tiver deadline maior
+ */
+void checkRealTimeStart(StructureCollection *structures, int instant){
+    Device *cpu = structures->devices->cpu;
+    DeadlineHeap *heap = structures->queues->realTime;
+    Process *candidate = peekDeadline(heap);
+    if(!candidate) return;
+
+    Process *running = cpu->actualProcess;
+    if(running){
+        if(running->realTime && running->absoluteDeadline <= candidate->absoluteDeadline) return;
+
+        printf("> Processo %d preemptado pelo processo de tempo real %d\n", running->pid, candidate->pid);
+        if(running->realTime) pushDeadline(heap, running);
+        else returnProcessFront(structures->queues, running);
+        structures->statistics->preemptions++;
+        releaseCPUs(structures->devices, running);
+    }
+
+    dispatchCPU(cpu, popDeadline(heap), structures->statistics, instant);
+}
+
+/*
+ * Contabiliza o atraso do processo com deadline e libera sua utilizacao
+ */
+void finishRealTimeProcess(StructureCollection *structures, Process *process){
+    int lateness = process->finishTime - process->absoluteDeadline;
+
+    addSample(structures->statistics->lateness, lateness);
+    if(lateness > 0){
+        structures->statistics->deadlineMisses++;
+        printf("! Processo %d perdeu o deadline por %d ut\n", process->pid, lateness);
+    }
+
+    if(process->realTime) structures->queues->realTime->utilization -= processUtilization(process);
+}
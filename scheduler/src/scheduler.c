@@ -2,43 +2,64 @@
 
 void scheduler(StructureCollection *structures);
 void executeDevice(Device *device);
-void checkDeviceEnd(Device *device, ProcessQueueDescriptor *returnQueue);
+void checkDeviceEnd(Device *device, QueueCollection *queues, ProcessQueueDescriptor *returnQueue);
 void checkDeviceStart(Device *device, ProcessQueueDescriptor *inputQueue);
+void dispatchCPU(Device *cpu, Process *process, Statistics *statistics, int instant);
+void releaseCPUs(DeviceCollection *devices, Process *process);
+void checkCPUEnd(StructureCollection *structures, Device *cpu);
+void checkCPUStart(Device *cpu, ProcessQueueDescriptor *inputQueue, Statistics *statistics, int instant);
+int cacheWarmthPenalty(Process *process, int instant);
 void addNewProcessToQueue(int instant, ProcessQueueDescriptor *queue, StructureCollection *structures);
-void killProcess(Device *cpu, int *killedProcesses);
-void checkProcessIO(Device *cpu);
-void executeCPU(Device *cpu, int *numProcesses);
+void killProcess(Device *cpu, int *killedProcesses, StructureCollection *structures, int instant);
+void checkProcessIO(Device *cpu, DeviceCollection *devices, int instant);
+void executeCPU(Device *cpu, int *numProcesses, StructureCollection *structures, int instant);
+void collectStatistics(StructureCollection *structures);
+void printStatistics(StructureCollection *structures);
 
 /*
  * Simula o escalonador
  */
 void scheduler(StructureCollection *structures){
     int killedProcesses = 0;
-    for(int instant = 0; killedProcesses < structures->numProcesses; instant++){
+    int instant;
+    for(instant = 0; killedProcesses < structures->numProcesses; instant++){
         printf("=== Começando instante %d ===\n", instant);
         printf("Atualmente tem %d processo(s) total(is), %d processo(s) em execução e %d processo(s) morto(s)\n", structures->numProcesses, structures->actualProcessIndex, killedProcesses);
 
+        if(structures->queues->groups) refreshGroupQuotas(structures->queues->groups, instant);
         addNewProcessToQueue(instant, structures->queues->highPriority, structures); // adicionar novo processo na fila de alta prioridade
 
-        checkDeviceStart(structures->devices->disk, structures->queues->diskQueue);
+        checkDiskStart(structures);
         checkDeviceStart(structures->devices->tape, structures->queues->tapeQueue);
         checkDeviceStart(structures->devices->printer, structures->queues->printerQueue);
-        checkDeviceStart(structures->devices->cpu, structures->queues->highPriority);
-        checkDeviceStart(structures->devices->cpu, structures->queues->lowPriority);
+        if(structures->devices->numCpus > 1){
+            checkGangStart(structures, instant);
+        }else{
+            checkRealTimeStart(structures, instant);
+            if(structures->queues->groups) checkGroupStart(structures, instant);
+            checkCPUStart(structures->devices->cpu, structures->queues->highPriority, structures->statistics, instant);
+            checkCPUStart(structures->devices->cpu, structures->queues->lowPriority, structures->statistics, instant);
+        }
 
         executeDevice(structures->devices->disk);
         executeDevice(structures->devices->tape);
         executeDevice(structures->devices->printer);
 
-        executeCPU(structures->devices->cpu, &killedProcesses);
+        for(int i = 0; i < structures->devices->numCpus; i++)
+            executeCPU(structures->devices->cpus[i], &killedProcesses, structures, instant);
 
-        checkDeviceEnd(structures->devices->disk, structures->queues->lowPriority);
-        checkDeviceEnd(structures->devices->tape, structures->queues->highPriority);
-        checkDeviceEnd(structures->devices->printer, structures->queues->highPriority);
-        checkDeviceEnd(structures->devices->cpu, structures->queues->lowPriority);
+        checkDiskEnd(structures, feedbackQueue(structures->queues, DISK_RETURN), instant);
+        checkDeviceEnd(structures->devices->tape, structures->queues, feedbackQueue(structures->queues, TAPE_RETURN));
+        checkDeviceEnd(structures->devices->printer, structures->queues, feedbackQueue(structures->queues, PRINTER_RETURN));
+        for(int i = 0; i < structures->devices->numCpus; i++)
+            checkCPUEnd(structures, structures->devices->cpus[i]);
 
         printf("\n\n");
     }
+    structures->statistics->instants = instant;
+
+    collectStatistics(structures);
+    printStatistics(structures);
 }
 
 /*
@@ -53,16 +74,42 @@ void executeDevice(Device *device){
 /*
  * Verifica se o dispositivo chegou ao fim
  */
-void checkDeviceEnd(Device *device, ProcessQueueDescriptor *returnQueue){
+void checkDeviceEnd(Device *device, QueueCollection *queues, ProcessQueueDescriptor *returnQueue){
     if(!device->actualProcess) return;
 
     if(device->remainingTime == 0){
-        addQueue(returnQueue, device->actualProcess);
+        returnProcess(queues, returnQueue, device->actualProcess);
         printf("- Processo %d saiu do dispositivo %s\n", device->actualProcess->pid, device->name);
         device->actualProcess = NULL;
     }
 }
 
+/*
+ * Verifica se o quantum do processo na CPU chegou ao fim, liberando todas as CPUs das suas threads
+ */
+void checkCPUEnd(StructureCollection *structures, Device *cpu){
+    Process *process = cpu->actualProcess;
+    if(!process || cpu->remainingTime) return;
+
+    releaseCPUs(structures->devices, process);
+    returnProcess(structures->queues, structures->queues->lowPriority, process);
+    printf("- Processo %d saiu do dispositivo %s\n", process->pid, cpu->name);
+}
+
+/*
+ * Retira o processo de todas as CPUs que ele ocupa
+ */
+void releaseCPUs(DeviceCollection *devices, Process *process){
+    for(int i = 0; i < devices->numCpus; i++){
+        if(devices->cpus[i]->actualProcess != process) continue;
+
+        devices->cpus[i]->actualProcess = NULL;
+        devices->cpus[i]->overheadTime = 0;
+        devices->cpus[i]->cacheOverheadTime = 0;
+    }
+    process->runningThreads = 0;
+}
+
 /*
  * Verifica se ha um processo para entrada no dispositivo
  */
@@ -76,13 +123,55 @@ void checkDeviceStart(Device *device, ProcessQueueDescriptor *inputQueue){
         printf("+ Processo %d entrou no dispositivo %s\n", device->actualProcess->pid, device->name);
 }    
 
+/*
+ * Penalidade de cache frio: o calor da cache cai pela metade a cada CACHE_HALF_LIFE ut sem executar
+ */
+int cacheWarmthPenalty(Process *process, int instant){
+    if(process->lastRunTime == -1 || !CACHE_HALF_LIFE) return CACHE_PENALTY;
+
+    int halvings = (instant - process->lastRunTime) / CACHE_HALF_LIFE;
+    if(halvings >= 31) return CACHE_PENALTY;
+    return CACHE_PENALTY - (CACHE_PENALTY >> halvings);
+}
+
+/*
+ * Verifica se ha um processo para entrada na CPU
+ */
+void checkCPUStart(Device *cpu, ProcessQueueDescriptor *inputQueue, Statistics *statistics, int instant){
+    if(cpu->actualProcess) return;
+
+    Process *process = removeQueue(inputQueue);
+    if(process) dispatchCPU(cpu, process, statistics, instant);
+    else cpu->remainingTime = cpu->duration;
+}
+
+/*
+ * Coloca o processo na CPU com a troca de contexto a pagar quando o processo muda. O custo so entra nas
+ * estatisticas a medida que a CPU o executa, entao um processo preemptado antes de executar nao conta a troca
+ */
+void dispatchCPU(Device *cpu, Process *process, Statistics *statistics, int instant){
+    cpu->actualProcess = process;
+    cpu->remainingTime = cpu->duration;
+    process->runningThreads++;
+    printf("+ Processo %d entrou no dispositivo %s\n", process->pid, cpu->name);
+
+    if(process == cpu->lastProcess) return;
+
+    int cachePenalty = cacheWarmthPenalty(cpu->actualProcess, instant);
+    cpu->overheadTime = CONTEXT_SWITCH_COST + cachePenalty;
+    cpu->cacheOverheadTime = cachePenalty;
+
+    if(cpu->overheadTime) printf("+ Troca de contexto para o processo %d custa %d ut (%d de cache fria)\n", cpu->actualProcess->pid, cpu->overheadTime, cachePenalty);
+}
+
 /*
  * Adiciona novos processos de acordo com seu tempo de chegada
  */
 void addNewProcessToQueue(int instant, ProcessQueueDescriptor *queue, StructureCollection *structures){
     while(structures->actualProcessIndex < structures->numProcesses && structures->processes[structures->actualProcessIndex].arrivalTime == instant){
         Process *actualProcess = &structures->processes[structures->actualProcessIndex];
-        addQueue(queue, actualProcess);
+        if(actualProcess->deadline) addRealTimeProcess(structures, actualProcess, queue);
+        else returnProcess(structures->queues, queue, actualProcess);
         printf("Processo %d escalonado no instante %d\n", actualProcess->pid, instant);
         structures->actualProcessIndex++;
     }
@@ -91,10 +180,13 @@ void addNewProcessToQueue(int instant, ProcessQueueDescriptor *queue, StructureC
 /*
  * Mata o processo
  */
-void killProcess(Device *cpu, int *killedProcesses){
+void killProcess(Device *cpu, int *killedProcesses, StructureCollection *structures, int instant){
     if(cpu->actualProcess->processedTime == cpu->actualProcess->serviceTime){
-        printf("X Processo %d foi finalizado\n", cpu->actualProcess->pid);
-        cpu->actualProcess = NULL;
+        Process *process = cpu->actualProcess;
+        printf("X Processo %d foi finalizado\n", process->pid);
+        process->finishTime = instant + 1;
+        if(process->deadline) finishRealTimeProcess(structures, process);
+        releaseCPUs(structures->devices, process);
         *(killedProcesses) += 1;
     }
 }
@@ -102,29 +194,113 @@ void killProcess(Device *cpu, int *killedProcesses){
 /*
  * Verifica se o processso atual da CPU possui IO
  */
-void checkProcessIO(Device *cpu){
+void checkProcessIO(Device *cpu, DeviceCollection *devices, int instant){
     if(!cpu->actualProcess) return;
     if(!cpu->actualProcess->IO) return;
 
     if (cpu->actualProcess->IO->initialTime == cpu->actualProcess->processedTime) {
         ProcessQueueDescriptor *device = cpu->actualProcess->IO->deviceQueue;
         printf("- Processo %d saiu da CPU\n",cpu->actualProcess->pid);
+        cpu->actualProcess->ioBlock = cpu->actualProcess->IO->block;
+        cpu->actualProcess->ioRequestTime = instant;
         cpu->actualProcess->IO = (cpu->actualProcess->IO)+1;
-        addQueue(device, cpu->actualProcess);
-        cpu->actualProcess = NULL;
+        Process *process = cpu->actualProcess;
+        releaseCPUs(devices, process);
+        addQueue(device, process);
     } 
 }
 
 /*
  * Executa uma unidade de tempo da CPU
  */
-void executeCPU(Device *cpu, int *killedProcesses){
+void executeCPU(Device *cpu, int *killedProcesses, StructureCollection *structures, int instant){
+    Statistics *statistics = structures->statistics;
     if(cpu->actualProcess){
+        // A troca de contexto ocupa a CPU sem consumir o quantum do processo: primeiro a troca, depois a cache fria
+        if(cpu->overheadTime){
+            if(cpu->overheadTime > cpu->cacheOverheadTime) statistics->switchOverhead++;
+            else{
+                statistics->cacheOverhead++;
+                cpu->cacheOverheadTime--;
+            }
+            cpu->overheadTime--;
+            return;
+        }
+
+        Process *process = cpu->actualProcess;
+        Group *group = process->group;
+        if(process != cpu->lastProcess){
+            statistics->contextSwitches++;
+            cpu->lastProcess = process;
+        }
+        statistics->cpuBusyTime++;
+        if(process->firstRunTime == -1) process->firstRunTime = instant;
+        process->lastRunTime = instant;
         cpu->remainingTime -= 1;
-        cpu->actualProcess->processedTime += 1;
 
-        killProcess(cpu, killedProcesses);
+        // Cada CPU executa uma thread; o processo avanca uma ut quando todas as suas threads avancam
+        if(++process->threadProgress < process->threads) return;
+        process->threadProgress -= process->threads;
+        process->processedTime += 1;
+
+        killProcess(cpu, killedProcesses, structures, instant);
         
-        checkProcessIO(cpu);
+        checkProcessIO(cpu, structures->devices, instant);
+
+        if(group) chargeGroup(structures, cpu, group, instant);
+    }
+}
+
+/*
+ * Coleta as metricas por processo ao fim da simulacao
+ */
+void collectStatistics(StructureCollection *structures){
+    Statistics *statistics = structures->statistics;
+
+    for(int i = 0; i < structures->numProcesses; i++){
+        Process *process = &structures->processes[i];
+        addSample(statistics->turnaround, process->finishTime - process->arrivalTime);
+        addSample(statistics->response, process->firstRunTime - process->arrivalTime);
     }
 }
+
+/*
+ * Imprime as estatisticas da simulacao
+ */
+void printStatistics(StructureCollection *structures){
+    Statistics *statistics = structures->statistics;
+
+    printf("=== Estatisticas ===\n");
+    printf("-> Instantes simulados: %d\n", statistics->instants);
+    printf("-> Throughput de processos: %.4f processo(s)/ut\n", statistics->instants ? (double)structures->numProcesses / statistics->instants : 0);
+    printSampleSet("Turnaround (ut)", statistics->turnaround);
+    printSampleSet("Tempo de resposta (ut)", statistics->response);
+
+    int overhead = statistics->switchOverhead + statistics->cacheOverhead;
+    printf("-> Trocas de contexto: %d\n", statistics->contextSwitches);
+    printf("-> Overhead total: %d ut (%d de troca de contexto, %d de cache fria)\n", overhead, statistics->switchOverhead, statistics->cacheOverhead);
+    printf("-> Eficiencia da CPU: %.2f%% do tempo ocupado em trabalho util\n", statistics->cpuBusyTime + overhead ? 100.0 * statistics->cpuBusyTime / (statistics->cpuBusyTime + overhead) : 0);
+    printf("-> Utilizacao util da CPU: %.2f%%\n", statistics->instants ? 100.0 * statistics->cpuBusyTime / (statistics->instants * structures->devices->numCpus) : 0);
+
+    if(structures->devices->numCpus > 1){
+        int cpuTime = statistics->instants * structures->devices->numCpus;
+        printf("-> CPUs: %d, coescalonamento %s\n", structures->devices->numCpus, COSCHEDULING == STRICT_GANG ? "em gangue estrita" : "relaxado");
+        printf("-> CPU ociosa por fragmentacao: %d ut (%.2f%%), ociosa sem trabalho: %d ut (%.2f%%)\n", statistics->fragmentedCpuTime,
+            cpuTime ? 100.0 * statistics->fragmentedCpuTime / cpuTime : 0, statistics->idleCpuTime, cpuTime ? 100.0 * statistics->idleCpuTime / cpuTime : 0);
+        printf("-> Processos colocados com menos CPUs que threads: %d\n", statistics->partialDispatches);
+    }
+
+    if(structures->queues->groups) printGroupStatistics(structures->queues->groups, statistics->instants);
+
+    if(statistics->deadlineProcesses){
+        printf("-> Processos com deadline: %d (%d admitido(s) na classe de tempo real, %d rejeitado(s))\n", statistics->deadlineProcesses, statistics->admittedProcesses, statistics->deadlineProcesses - statistics->admittedProcesses);
+        printf("-> Deadlines perdidos: %d, preempcoes: %d\n", statistics->deadlineMisses, statistics->preemptions);
+        printSampleSet("Atraso em relacao ao deadline (ut)", statistics->lateness);
+    }
+
+    printf("-> Politica do disco: %s\n", diskPolicyName(DISK_POLICY));
+    printf("-> Requisicoes de disco atendidas: %d\n", statistics->diskRequests);
+    printf("-> Throughput do disco: %.4f requisicao(oes)/ut\n", statistics->instants ? (double)statistics->diskRequests / statistics->instants : 0);
+    printf("-> Utilizacao do disco: %.2f%%\n", statistics->instants ? 100.0 * statistics->diskBusyTime / statistics->instants : 0);
+    printSampleSet("Latencia de disco (ut)", statistics->diskLatency);
+}
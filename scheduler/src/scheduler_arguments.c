@@ -4,6 +4,26 @@ int time_slice;
 int disk_timer;
 int tape_timer;
 int printer_timer;
+int disk_policy;
+int disk_seek_rate;
+int disk_rotation;
+int disk_merge;
+int context_switch_cost;
+int cache_penalty;
+int cache_half_life;
+int disk_return;
+int tape_return;
+int printer_return;
+int tune_objective;
+int tune_workers;
+int tune_max_quantum;
+int rt_utilization_bound;
+int real_time_class;
+int fair_share;
+int quota_period;
+int num_cpus;
+int coscheduling;
+int live_time_unit;
 
 int handleParameter(char *ps);
 void readArgumentsFromConsole(int argc, char *argv[]);
@@ -11,6 +31,28 @@ int getTimeSlice();
 int getDiskTimer();
 int getTapeTimer();
 int getPrinterTimer();
+int getDiskPolicy();
+int getDiskSeekRate();
+int getDiskRotation();
+int getDiskMerge();
+int getContextSwitchCost();
+int getCachePenalty();
+int getCacheHalfLife();
+int getDiskReturn();
+int getTapeReturn();
+int getPrinterReturn();
+int getTuneObjective();
+int getTuneWorkers();
+int getTuneMaxQuantum();
+int getRealTimeUtilizationBound();
+int getRealTimeClass();
+int getFairShare();
+int getQuotaPeriod();
+int getNumCpus();
+int getCoscheduling();
+int getLiveTimeUnit();
+void setTimeSlice(int value);
+void setFeedbackRouting(int routing);
 
 /*
  * Verifica se o parametro e um numero
@@ -35,6 +77,26 @@ void readArgumentsFromConsole(int argc, char *argv[]){
     disk_timer = 3;
     tape_timer = 5;
     printer_timer = 8;
+    disk_policy = 0;
+    disk_seek_rate = 0;
+    disk_rotation = 0;
+    disk_merge = 0;
+    context_switch_cost = 0;
+    cache_penalty = 0;
+    cache_half_life = 0;
+    disk_return = LOW_PRIORITY;
+    tape_return = HIGH_PRIORITY;
+    printer_return = HIGH_PRIORITY;
+    tune_objective = TUNE_DISABLED;
+    tune_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    tune_max_quantum = 16;
+    rt_utilization_bound = 100;
+    real_time_class = 0;
+    fair_share = 0;
+    quota_period = 10;
+    num_cpus = 1;
+    coscheduling = STRICT_GANG;
+    live_time_unit = 0;
 
     for(int i = 1; i < argc; i++){
         char *arg = argv[i];
@@ -56,6 +118,64 @@ void readArgumentsFromConsole(int argc, char *argv[]){
             case 'p':
                 printer_timer = handleParameter(arg);
                 break;
+            case 'e':
+                disk_policy = handleParameter(arg);
+                if(disk_policy > 3) exitProgram(INVALID_ARGUMENT, "Politica de disco invalida, use a opcao -h em caso de duvidas");
+                break;
+            case 's':
+                disk_seek_rate = handleParameter(arg);
+                break;
+            case 'r':
+                disk_rotation = handleParameter(arg);
+                break;
+            case 'm':
+                disk_merge = handleParameter(arg);
+                break;
+            case 'c':
+                context_switch_cost = handleParameter(arg);
+                break;
+            case 'w':
+                cache_penalty = handleParameter(arg);
+                break;
+            case 'k':
+                cache_half_life = handleParameter(arg);
+                break;
+            case 'f':
+                if(strlen(arg) != 3 || strspn(arg, "01") != 3) exitProgram(INVALID_ARGUMENT, "O retorno das filas deve ter 3 digitos 0 ou 1 (disco, fita e impressora)");
+                setFeedbackRouting(handleParameter(arg));
+                break;
+            case 'a':
+                tune_objective = handleParameter(arg);
+                if(tune_objective > TUNE_THROUGHPUT) exitProgram(INVALID_ARGUMENT, "Objetivo de ajuste invalido, use a opcao -h em caso de duvidas");
+                break;
+            case 'j':
+                tune_workers = handleParameter(arg);
+                break;
+            case 'x':
+                tune_max_quantum = handleParameter(arg);
+                break;
+            case 'u':
+                rt_utilization_bound = handleParameter(arg);
+                real_time_class = 1;
+                break;
+            case 'g':
+                fair_share = handleParameter(arg);
+                break;
+            case 'o':
+                quota_period = handleParameter(arg);
+                if(!quota_period) exitProgram(INVALID_NUMBER, "O periodo da cota deve ser maior que zero");
+                break;
+            case 'n':
+                num_cpus = handleParameter(arg);
+                if(num_cpus < 1 || num_cpus > MAX_CPUS) exitProgram(INVALID_ARGUMENT, "Quantidade de CPUs invalida, use a opcao -h em caso de duvidas");
+                break;
+            case 'l':
+                coscheduling = handleParameter(arg);
+                if(coscheduling > RELAXED_COSCHEDULING) exitProgram(INVALID_ARGUMENT, "Modo de coescalonamento invalido, use a opcao -h em caso de duvidas");
+                break;
+            case 'b':
+                live_time_unit = handleParameter(arg);
+                break;
             case 'h':
                 exitProgram(HELP, HELP_TEXT);
                 break;
@@ -63,6 +183,13 @@ void readArgumentsFromConsole(int argc, char *argv[]){
                 exitProgram(INVALID_ARGUMENT, "Nao foi passado um argumento valido, use a opcao -h em caso de duvidas");
         }
     }
+
+    if(num_cpus > 1 && fair_share) exitProgram(INVALID_ARGUMENT, "O compartilhamento justo so e suportado com uma CPU");
+    if(num_cpus > 1 && real_time_class) exitProgram(INVALID_ARGUMENT, "A classe de tempo real so e suportada com uma CPU");
+    if(live_time_unit && (fair_share || tune_objective)) exitProgram(INVALID_ARGUMENT, "A execucao real nao suporta compartilhamento justo nem ajuste automatico");
+    if(live_time_unit && (disk_policy || disk_seek_rate || disk_rotation || disk_merge)) exitProgram(INVALID_ARGUMENT, "A execucao real atende o disco em ordem de chegada, sem modelo de seek, rotacao ou juncao");
+    if(live_time_unit && (context_switch_cost || cache_penalty)) exitProgram(INVALID_ARGUMENT, "A execucao real nao cobra troca de contexto nem cache frio");
+    if(live_time_unit && real_time_class) exitProgram(INVALID_ARGUMENT, "A execucao real nao suporta a classe de tempo real");
 }
 
 /*
@@ -83,3 +210,102 @@ int getTapeTimer(){
 int getPrinterTimer(){
     return printer_timer;
 }
+
+int getDiskPolicy(){
+    return disk_policy;
+}
+
+int getDiskSeekRate(){
+    return disk_seek_rate;
+}
+
+int getDiskRotation(){
+    return disk_rotation;
+}
+
+int getDiskMerge(){
+    return disk_merge;
+}
+
+int getContextSwitchCost(){
+    return context_switch_cost;
+}
+
+int getCachePenalty(){
+    return cache_penalty;
+}
+
+int getCacheHalfLife(){
+    return cache_half_life;
+}
+
+int getDiskReturn(){
+    return disk_return;
+}
+
+int getTapeReturn(){
+    return tape_return;
+}
+
+int getPrinterReturn(){
+    return printer_return;
+}
+
+int getTuneObjective(){
+    return tune_objective;
+}
+
+int getTuneWorkers(){
+    return tune_workers > 0 ? tune_workers : 1;
+}
+
+int getTuneMaxQuantum(){
+    return tune_max_quantum > 0 ? tune_max_quantum : 1;
+}
+
+/*
+ * Setters usados pelo modo de ajuste automatico
+ */
+void setTimeSlice(int value){
+    time_slice = value;
+}
+
+/*
+ * Roteamento em 3 digitos (disco, fita, impressora): 0 volta para alta prioridade e 1 para baixa
+ */
+void setFeedbackRouting(int routing){
+    disk_return = routing / 100;
+    tape_return = routing / 10 % 10;
+    printer_return = routing % 10;
+}
+
+int getRealTimeUtilizationBound(){
+    return rt_utilization_bound;
+}
+
+/*
+ * A classe de tempo real foi pedida com -u: so assim os processos aleatorios e do teclado recebem deadline
+ */
+int getRealTimeClass(){
+    return real_time_class;
+}
+
+int getFairShare(){
+    return fair_share;
+}
+
+int getQuotaPeriod(){
+    return quota_period;
+}
+
+int getNumCpus(){
+    return num_cpus;
+}
+
+int getCoscheduling(){
+    return coscheduling;
+}
+
+int getLiveTimeUnit(){
+    return live_time_unit;
+}
@@ -0,0 +1,88 @@
+#include "../headers/statistics.h"
+
+SampleSet* createSampleSet();
+void addSample(SampleSet *set, int value);
+double meanSample(SampleSet *set);
+int percentileSample(SampleSet *set, double percentile);
+void printSampleSet(char *name, SampleSet *set);
+void destroySampleSet(SampleSet **set);
+int compareSamples(const void *a, const void *b);
+
+/*
+ * Cria um conjunto de amostras vazio
+ */
+SampleSet* createSampleSet(){
+    SampleSet *set = (SampleSet *)malloc(sizeof(SampleSet));
+    set->capacity = 16;
+    set->size = 0;
+    set->sorted = 1;
+    set->values = (int *)malloc(sizeof(int) * set->capacity);
+
+    return set;
+}
+
+/*
+ * Adiciona uma amostra ao conjunto, dobrando a capacidade quando necessario
+ */
+void addSample(SampleSet *set, int value){
+    if(set->size == set->capacity){
+        set->capacity *= 2;
+        set->values = (int *)realloc(set->values, sizeof(int) * set->capacity);
+    }
+    set->values[set->size++] = value;
+    set->sorted = 0;
+}
+
+/*
+ * Media das amostras
+ */
+double meanSample(SampleSet *set){
+    if(!set->size) return 0;
+
+    double sum = 0;
+    for(int i = 0; i < set->size; i++) sum += set->values[i];
+    return sum / set->size;
+}
+
+int compareSamples(const void *a, const void *b){
+    return *(const int *)a - *(const int *)b;
+}
+
+/*
+ * Percentil (0 a 100) das amostras pelo metodo nearest-rank
+ */
+int percentileSample(SampleSet *set, double percentile){
+    if(!set->size) return 0;
+
+    if(!set->sorted){
+        qsort(set->values, set->size, sizeof(int), compareSamples);
+        set->sorted = 1;
+    }
+
+    int rank = (int)(percentile / 100.0 * set->size + 0.999999);
+    if(rank < 1) rank = 1;
+    if(rank > set->size) rank = set->size;
+    return set->values[rank - 1];
+}
+
+/*
+ * Imprime o resumo da distribuicao
+ */
+void printSampleSet(char *name, SampleSet *set){
+    if(!set->size){
+        printf("-> %s: sem amostras\n", name);
+        return;
+    }
+    printf("-> %s: n=%d min=%d media=%.2f p50=%d p90=%d p99=%d max=%d\n", name, set->size,
+        percentileSample(set, 0), meanSample(set), percentileSample(set, 50),
+        percentileSample(set, 90), percentileSample(set, 99), percentileSample(set, 100));
+}
+
+/*
+ * Libera o conjunto de amostras
+ */
+void destroySampleSet(SampleSet **set){
+    free((*set)->values);
+    free(*set);
+    *set = NULL;
+}
@@ -1,9 +1,19 @@
 #include "../headers/structures.h"
+#include "../headers/fairshare.h"
 
 Device* createDevice(int time, char *name);
 ProcessQueueDescriptor* createQueue();
 void addQueue(ProcessQueueDescriptor *queue, Process *process);
 Process* removeQueue(ProcessQueueDescriptor *queue);
+Process* removeQueueAfter(ProcessQueueDescriptor *queue, ProcessQueueElement *previous);
+void addQueueFront(ProcessQueueDescriptor *queue, Process *process);
+DeadlineHeap* createDeadlineHeap();
+void pushDeadline(DeadlineHeap *heap, Process *process);
+Process* popDeadline(DeadlineHeap *heap);
+Process* peekDeadline(DeadlineHeap *heap);
+void returnProcess(QueueCollection *queues, ProcessQueueDescriptor *queue, Process *process);
+void returnProcessFront(QueueCollection *queues, Process *process);
+ProcessQueueDescriptor* feedbackQueue(QueueCollection *queues, int priority);
 StructureCollection* createStructures(int readProcessesFrom);
 void destroyStructures(StructureCollection **collection);
 
@@ -14,6 +24,9 @@ Device* createDevice(int time, char *name){
     Device *device = (Device *)malloc(sizeof(Device));
     device->remainingTime = device->duration = time;
     device->actualProcess = NULL;
+    device->lastProcess = NULL;
+    device->overheadTime = 0;
+    device->cacheOverheadTime = 0;
     strcpy(device->name, name);
 
     return device;
@@ -62,6 +75,121 @@ Process* removeQueue(ProcessQueueDescriptor *queue){
     return process;
 }
 
+/*
+ * Remove o processo seguinte ao elemento informado (ou a cabeca, se o elemento for NULL)
+ */
+Process* removeQueueAfter(ProcessQueueDescriptor *queue, ProcessQueueElement *previous){
+    if(!previous) return removeQueue(queue);
+    if(!previous->next) return NULL;
+
+    ProcessQueueElement *element = previous->next;
+    Process *process = element->process;
+
+    previous->next = element->next;
+    if(queue->tail == element) queue->tail = previous;
+    free(element);
+
+    return process;
+}
+
+/*
+ * Adiciona um processo no inicio da fila
+ */
+void addQueueFront(ProcessQueueDescriptor *queue, Process *process){
+    if(!process) return;
+
+    ProcessQueueElement *processQueue = (ProcessQueueElement *)malloc(sizeof(ProcessQueueElement));
+    processQueue->process = process;
+    processQueue->next = queue->head;
+
+    queue->head = processQueue;
+    if(!queue->tail) queue->tail = processQueue;
+}
+
+/*
+ * Cria o heap de deadlines
+ */
+DeadlineHeap* createDeadlineHeap(){
+    DeadlineHeap *heap = (DeadlineHeap *)malloc(sizeof(DeadlineHeap));
+    heap->capacity = MAX_PROCESSES;
+    heap->size = 0;
+    heap->utilization = 0;
+    heap->processes = (Process **)malloc(sizeof(Process *) * heap->capacity);
+
+    return heap;
+}
+
+/*
+ * Insere um processo no heap em O(log n)
+ */
+void pushDeadline(DeadlineHeap *heap, Process *process){
+    if(heap->size == heap->capacity){
+        heap->capacity *= 2;
+        heap->processes = (Process **)realloc(heap->processes, sizeof(Process *) * heap->capacity);
+    }
+
+    int i = heap->size++;
+    while(i > 0 && heap->processes[(i - 1) / 2]->absoluteDeadline > process->absoluteDeadline){
+        heap->processes[i] = heap->processes[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->processes[i] = process;
+}
+
+/*
+ * Remove o processo de menor deadline absoluto em O(log n)
+ */
+Process* popDeadline(DeadlineHeap *heap){
+    if(!heap->size) return NULL;
+
+    Process *top = heap->processes[0];
+    Process *last = heap->processes[--heap->size];
+
+    int i = 0;
+    while(2 * i + 1 < heap->size){
+        int child = 2 * i + 1;
+        if(child + 1 < heap->size && heap->processes[child + 1]->absoluteDeadline < heap->processes[child]->absoluteDeadline) child++;
+        if(last->absoluteDeadline <= heap->processes[child]->absoluteDeadline) break;
+
+        heap->processes[i] = heap->processes[child];
+        i = child;
+    }
+    heap->processes[i] = last;
+
+    return top;
+}
+
+/*
+ * Processo de menor deadline absoluto sem remover
+ */
+Process* peekDeadline(DeadlineHeap *heap){
+    return heap->size ? heap->processes[0] : NULL;
+}
+
+/*
+ * Devolve o processo para a fila informada, ou para o heap de deadlines se for de tempo real
+ */
+void returnProcess(QueueCollection *queues, ProcessQueueDescriptor *queue, Process *process){
+    if(process->realTime) pushDeadline(queues->realTime, process);
+    else if(queues->groups) addGroupQueue(queues->groups, process, queue == queues->lowPriority ? LOW_PRIORITY : HIGH_PRIORITY, 0);
+    else addQueue(queue, process);
+}
+
+/*
+ * Devolve o processo preemptado para o inicio da fila de alta prioridade (do seu grupo, se houver)
+ */
+void returnProcessFront(QueueCollection *queues, Process *process){
+    if(queues->groups) addGroupQueue(queues->groups, process, HIGH_PRIORITY, 1);
+    else addQueueFront(queues->highPriority, process);
+}
+
+/*
+ * Fila de prioridade para onde volta o processo
+ */
+ProcessQueueDescriptor* feedbackQueue(QueueCollection *queues, int priority){
+    return priority == HIGH_PRIORITY ? queues->highPriority : queues->lowPriority;
+}
+
 /*
  * Cria as estruturas basicas
  */
@@ -69,12 +197,25 @@ StructureCollection* createStructures(int readProcessesFrom){
     StructureCollection *collection = (StructureCollection *)malloc(sizeof(StructureCollection));
     
     collection->devices = (DeviceCollection *)malloc(sizeof(DeviceCollection));
-    collection->devices->cpu = createDevice(TIME_SLICE, "CPU");
+    collection->devices->numCpus = NUM_CPUS;
+    for(int i = 0; i < NUM_CPUS; i++){
+        char name[16];
+        if(NUM_CPUS == 1) strcpy(name, "CPU");
+        else sprintf(name, "CPU %d", i);
+        collection->devices->cpus[i] = createDevice(TIME_SLICE, name);
+    }
+    collection->devices->cpu = collection->devices->cpus[0];
     collection->devices->disk = createDevice(DISK_TIMER, "Disco");
     collection->devices->tape = createDevice(TAPE_TIMER, "Fita");
     collection->devices->printer = createDevice(PRINTER_TIME, "Impressora");
 
+    collection->devices->diskState = (DiskState *)malloc(sizeof(DiskState));
+    collection->devices->diskState->cylinder = 0;
+    collection->devices->diskState->direction = 1;
+    collection->devices->diskState->merged = createQueue();
+
     collection->queues = (QueueCollection *)malloc(sizeof(QueueCollection));
+    collection->queues->realTime = createDeadlineHeap();
     collection->queues->highPriority = createQueue();
     collection->queues->lowPriority = createQueue();
     collection->queues->diskQueue = createQueue();
@@ -83,6 +224,28 @@ StructureCollection* createStructures(int readProcessesFrom){
 
     collection->processes = createProcesses(readProcessesFrom, &collection->numProcesses, collection->queues);
     collection->actualProcessIndex = 0;
+    collection->queues->groups = FAIR_SHARE ? createGroupScheduler(collection->processes, collection->numProcesses) : NULL;
+
+    collection->statistics = (Statistics *)malloc(sizeof(Statistics));
+    collection->statistics->instants = 0;
+    collection->statistics->diskRequests = 0;
+    collection->statistics->diskBusyTime = 0;
+    collection->statistics->cpuBusyTime = 0;
+    collection->statistics->contextSwitches = 0;
+    collection->statistics->switchOverhead = 0;
+    collection->statistics->cacheOverhead = 0;
+    collection->statistics->fragmentedCpuTime = 0;
+    collection->statistics->idleCpuTime = 0;
+    collection->statistics->partialDispatches = 0;
+    collection->statistics->diskLatency = createSampleSet();
+    collection->statistics->turnaround = createSampleSet();
+    collection->statistics->response = createSampleSet();
+    collection->statistics->deadlineProcesses = 0;
+    collection->statistics->admittedProcesses = 0;
+    collection->statistics->deadlineMisses = 0;
+    collection->statistics->preemptions = 0;
+    collection->statistics->lateness = createSampleSet();
+
     printf("%d processo(s) criado(s) com sucesso\n\n", collection->numProcesses);
 
     return collection;
@@ -92,12 +255,17 @@ StructureCollection* createStructures(int readProcessesFrom){
  * Libera as estruturas
  */
 void destroyStructures(StructureCollection **collection){
-    free((*collection)->devices->cpu);
+    for(int i = 0; i < (*collection)->devices->numCpus; i++) free((*collection)->devices->cpus[i]);
     free((*collection)->devices->disk);
     free((*collection)->devices->tape);
     free((*collection)->devices->printer);
+    free((*collection)->devices->diskState->merged);
+    free((*collection)->devices->diskState);
     free((*collection)->devices);
 
+    free((*collection)->queues->realTime->processes);
+    free((*collection)->queues->realTime);
+    if((*collection)->queues->groups) destroyGroupScheduler(&(*collection)->queues->groups);
     free((*collection)->queues->highPriority);
     free((*collection)->queues->lowPriority);
     free((*collection)->queues->diskQueue);
@@ -107,5 +275,11 @@ void destroyStructures(StructureCollection **collection){
 
     free((*collection)->processes);
 
+    destroySampleSet(&(*collection)->statistics->diskLatency);
+    destroySampleSet(&(*collection)->statistics->turnaround);
+    destroySampleSet(&(*collection)->statistics->response);
+    destroySampleSet(&(*collection)->statistics->lateness);
+    free((*collection)->statistics);
+
     free((*collection));
 }
\ No newline at end of file
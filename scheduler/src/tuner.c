@@ -0,0 +1,182 @@
+#include "../headers/tuner.h"
+#include <sys/wait.h>
+
+void autoTune(StructureCollection *structures);
+void simulateConfiguration(StructureCollection *structures, TuningResult *result, int outputFd);
+void evaluateConfigurations(StructureCollection *structures, TuningResult *results, int count);
+int addConfiguration(TuningResult *results, int count, int quantum, int routing);
+double tuningScore(TuningResult *result);
+int bestConfiguration(TuningResult *results, int count, int exclude[], int excluded);
+int routingFromIndex(int index);
+void printTuningResult(TuningResult *result);
+
+/*
+ * Converte o indice (0 a 7) no roteamento de 3 digitos (disco, fita, impressora)
+ */
+int routingFromIndex(int index){
+    return (index >> 2 & 1) * 100 + (index >> 1 & 1) * 10 + (index & 1);
+}
+
+/*
+ * Executa a simulacao de uma configuracao no processo filho e envia as metricas pelo pipe
+ */
+void simulateConfiguration(StructureCollection *structures, TuningResult *result, int outputFd){
+    if(!freopen("/dev/null", "w", stdout)) _exit(FILE_ERROR);
+
+    setTimeSlice(result->quantum);
+    setFeedbackRouting(result->routing);
+    for(int i = 0; i < structures->devices->numCpus; i++)
+        structures->devices->cpus[i]->duration = structures->devices->cpus[i]->remainingTime = TIME_SLICE;
+
+    scheduler(structures);
+
+    Statistics *statistics = structures->statistics;
+    result->meanResponse = meanSample(statistics->response);
+    result->p99Turnaround = percentileSample(statistics->turnaround, 99);
+    result->throughput = statistics->instants ? (double)structures->numProcesses / statistics->instants : 0;
+    result->valid = 1;
+
+    if(write(outputFd, result, sizeof(TuningResult)) != sizeof(TuningResult)) _exit(FILE_ERROR);
+    close(outputFd);
+    _exit(NO_ERROR);
+}
+
+/*
+ * Avalia as configuracoes ainda nao avaliadas, com ate TUNE_WORKERS simulacoes simultaneas.
+ * Cada simulacao roda em um processo filho, que herda uma copia intacta da carga de trabalho
+ */
+void evaluateConfigurations(StructureCollection *structures, TuningResult *results, int count){
+    int *pipes = (int *)malloc(sizeof(int) * count);
+    pid_t *children = (pid_t *)malloc(sizeof(pid_t) * count);
+    int running = 0;
+
+    fflush(stdout);
+    for(int i = 0; i <= count; i++){
+        // Espera um filho terminar quando todos os workers estao ocupados ou no fim da fila
+        while(running && (running == TUNE_WORKERS || i == count)){
+            pid_t child = wait(NULL);
+            for(int j = 0; j < i; j++){
+                if(children[j] != child) continue;
+                if(read(pipes[j], &results[j], sizeof(TuningResult)) != sizeof(TuningResult)) results[j].valid = 0;
+                close(pipes[j]);
+                children[j] = 0;
+                running--;
+            }
+        }
+        if(i == count) break;
+
+        children[i] = 0;
+        if(results[i].valid) continue;
+
+        int fd[2];
+        if(pipe(fd)) exitProgram(FILE_ERROR, "Falha ao criar pipe para o ajuste automatico");
+
+        children[i] = fork();
+        if(children[i] == 0){
+            close(fd[0]);
+            simulateConfiguration(structures, &results[i], fd[1]);
+        }
+        close(fd[1]);
+        if(children[i] < 0) exitProgram(FILE_ERROR, "Falha ao criar processo para o ajuste automatico");
+
+        pipes[i] = fd[0];
+        running++;
+    }
+
+    free(pipes);
+    free(children);
+}
+
+/*
+ * Adiciona uma configuracao na lista caso ainda nao exista
+ */
+int addConfiguration(TuningResult *results, int count, int quantum, int routing){
+    for(int i = 0; i < count; i++)
+        if(results[i].quantum == quantum && results[i].routing == routing) return count;
+
+    results[count].quantum = quantum;
+    results[count].routing = routing;
+    results[count].valid = 0;
+    return count + 1;
+}
+
+/*
+ * Valor a ser minimizado de acordo com o objetivo escolhido
+ */
+double tuningScore(TuningResult *result){
+    switch(TUNE_OBJECTIVE){
+        case TUNE_MEAN_RESPONSE:
+            return result->meanResponse;
+        case TUNE_P99_TURNAROUND:
+            return result->p99Turnaround;
+    }
+    return -result->throughput;
+}
+
+/*
+ * Indice da melhor configuracao valida, ignorando os indices excluidos
+ */
+int bestConfiguration(TuningResult *results, int count, int exclude[], int excluded){
+    int best = -1;
+    for(int i = 0; i < count; i++){
+        if(!results[i].valid) continue;
+
+        int skip = 0;
+        for(int j = 0; j < excluded; j++) skip |= exclude[j] == i;
+        if(skip) continue;
+
+        if(best == -1 || tuningScore(&results[i]) < tuningScore(&results[best])) best = i;
+    }
+    return best;
+}
+
+void printTuningResult(TuningResult *result){
+    printf("-> quantum %2d | retorno %03d | resposta media %.2f | turnaround p99 %d | throughput %.4f\n",
+        result->quantum, result->routing, result->meanResponse, result->p99Turnaround, result->throughput);
+}
+
+/*
+ * Busca o quantum e o roteamento de retorno que otimizam o objetivo escolhido.
+ * Fase 1: grade grossa com quantums em potencias de 2 e todos os roteamentos.
+ * Fase 2: refinamento com todos os quantums inteiros ao redor das 3 melhores configuracoes
+ */
+void autoTune(StructureCollection *structures){
+    int maxConfigurations = TUNE_MAX_QUANTUM * ROUTINGS;
+    TuningResult *results = (TuningResult *)malloc(sizeof(TuningResult) * maxConfigurations);
+    int count = 0;
+
+    char *objectives[] = {"", "tempo de resposta medio", "turnaround p99", "throughput"};
+    printf("=== Ajuste automatico (%s) com %d simulacao(oes) em paralelo ===\n", objectives[TUNE_OBJECTIVE], TUNE_WORKERS);
+
+    for(int quantum = 1; ; quantum *= 2){
+        if(quantum > TUNE_MAX_QUANTUM) quantum = TUNE_MAX_QUANTUM;
+        for(int routing = 0; routing < ROUTINGS; routing++)
+            count = addConfiguration(results, count, quantum, routingFromIndex(routing));
+        if(quantum == TUNE_MAX_QUANTUM) break;
+    }
+    evaluateConfigurations(structures, results, count);
+    int coarseCount = count;
+
+    int top[3], numTop = 0;
+    while(numTop < 3 && (top[numTop] = bestConfiguration(results, coarseCount, top, numTop)) != -1) numTop++;
+
+    for(int i = 0; i < numTop; i++){
+        int quantum = results[top[i]].quantum, routing = results[top[i]].routing;
+        for(int q = quantum / 2 + 1; q < quantum * 2 && q <= TUNE_MAX_QUANTUM; q++)
+            count = addConfiguration(results, count, q, routing);
+    }
+    evaluateConfigurations(structures, results, count);
+
+    printf("Fase 1: %d configuracao(oes) na grade grossa, fase 2: %d no refinamento\n", coarseCount, count - coarseCount);
+    for(int i = 0; i < count; i++)
+        if(results[i].valid) printTuningResult(&results[i]);
+
+    int best = bestConfiguration(results, count, NULL, 0);
+    if(best == -1) exitProgram(FILE_ERROR, "Nenhuma simulacao do ajuste automatico terminou com sucesso");
+
+    printf("\n=== Melhor configuracao ===\n");
+    printTuningResult(&results[best]);
+    printf("Use: make run QUANTUM_SIZE=%d FEEDBACK_ROUTING=%03d\n", results[best].quantum, results[best].routing);
+
+    free(results);
+}